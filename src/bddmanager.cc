@@ -0,0 +1,461 @@
+/*
+ * Copyright 2024 Alwin Leerling <dna.leerling@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#include "bddmanager.h"
+
+#include <algorithm>
+
+const BddManager::Node BddManager::false_node;
+const BddManager::Node BddManager::true_node;
+const unsigned int BddManager::max_variables;
+const size_t BddManager::default_node_limit;
+
+static const size_t initial_unique_size = 1 << 12;
+static const size_t computed_cache_size = 1 << 16;
+
+static size_t hash_triple( unsigned int a, unsigned int b, unsigned int c )
+{
+	uint64_t hash = (uint64_t( a ) * 0x9E3779B97F4A7C15ULL) ^ (uint64_t( b ) * 0xC2B2AE3D27D4EB4FULL) ^ (uint64_t( c ) * 0x165667B19E3779F9ULL);
+
+	return hash ^ (hash >> 29);
+}
+
+BddManager::BddManager( unsigned int no_of_variables, size_t node_limit )
+{
+	std::vector<unsigned int> natural_order;
+
+	this->no_of_variables = std::min( no_of_variables, max_variables );
+	this->node_limit = node_limit;
+
+	for( unsigned int index = 0; index < this->no_of_variables; ++index )
+		natural_order.push_back( index );
+
+	set_order( natural_order );
+}
+
+/* Changing the order invalidates every node, so it starts from an empty diagram
+ */
+void BddManager::set_order( const std::vector<unsigned int>& new_order )
+{
+	order = new_order;
+	levels.assign( no_of_variables, 0 );
+
+	for( unsigned int level = 0; level < order.size(); ++level )
+		levels[order[level]] = level;
+
+	overflowed = false;
+
+	nodes.clear();
+	nodes.push_back( NodeData { no_of_variables, false_node, false_node } );
+	nodes.push_back( NodeData { no_of_variables, true_node, true_node } );
+
+	unique_table.assign( initial_unique_size, false_node );
+	computed_cache.assign( computed_cache_size, CacheEntry { 0, 0, 0, 0 } );
+}
+
+size_t BddManager::count_nodes( const std::vector<Node>& roots ) const
+{
+	std::vector<bool> visited( nodes.size(), false );
+	std::vector<Node> pending( roots );
+	size_t count = 0;
+
+	while( !pending.empty() ) {
+		Node f = pending.back();
+
+		pending.pop_back();
+
+		if( (f <= true_node) || visited[f] )
+			continue;
+
+		visited[f] = true;
+		++count;
+
+		pending.push_back( nodes[f].low );
+		pending.push_back( nodes[f].high );
+	}
+
+	return count;
+}
+
+BddManager::Node BddManager::variable( unsigned int index )
+{
+	return make_node( index, false_node, true_node );
+}
+
+BddManager::Node BddManager::cofactor( Node f, unsigned int level, bool value ) const
+{
+	if( get_level( f ) != level )
+		return f;
+
+	return value ? nodes[f].high : nodes[f].low;
+}
+
+BddManager::Node BddManager::make_node( unsigned int variable, Node low, Node high )
+{
+	if( low == high )
+		return low;
+
+	size_t mask = unique_table.size() - 1;
+	size_t slot = hash_triple( variable, low, high ) & mask;
+
+	for( ; unique_table[slot] != false_node; slot = (slot + 1) & mask ) {
+		const NodeData& node = nodes[unique_table[slot]];
+
+		if( (node.variable == variable) && (node.low == low) && (node.high == high) )
+			return unique_table[slot];
+	}
+
+	if( nodes.size() >= node_limit ) {
+		overflowed = true;
+		return false_node;
+	}
+
+	unique_table[slot] = nodes.size();
+	nodes.push_back( NodeData { variable, low, high } );
+
+	/* keep the table at most three quarters full, the terminals are not in it
+	 */
+	if( (nodes.size() - 2) * 4 > unique_table.size() * 3 )
+		grow_unique_table();
+
+	return nodes.size() - 1;
+}
+
+void BddManager::grow_unique_table()
+{
+	fill_unique_table( unique_table.size() * 2 );
+}
+
+void BddManager::fill_unique_table( size_t size )
+{
+	unique_table.assign( size, false_node );
+
+	size_t mask = unique_table.size() - 1;
+
+	for( Node f = true_node + 1; f < nodes.size(); ++f ) {
+		size_t slot = hash_triple( nodes[f].variable, nodes[f].low, nodes[f].high ) & mask;
+
+		while( unique_table[slot] != false_node )
+			slot = (slot + 1) & mask;
+
+		unique_table[slot] = f;
+	}
+}
+
+BddManager::Node BddManager::ite( Node f, Node g, Node h )
+{
+	if( overflowed )
+		return false_node;
+
+	if( f == true_node )
+		return g;
+
+	if( f == false_node )
+		return h;
+
+	if( g == h )
+		return g;
+
+	if( (g == true_node) && (h == false_node) )
+		return f;
+
+	CacheEntry& entry = computed_cache[hash_triple( f, g, h ) & (computed_cache.size() - 1)];
+
+	if( (entry.f == f) && (entry.g == g) && (entry.h == h) )
+		return entry.result;
+
+	unsigned int top = std::min( get_level( f ), std::min( get_level( g ), get_level( h ) ) );
+
+	Node high = ite( cofactor( f, top, true ), cofactor( g, top, true ), cofactor( h, top, true ) );
+	Node low = ite( cofactor( f, top, false ), cofactor( g, top, false ), cofactor( h, top, false ) );
+	Node result = make_node( order[top], low, high );
+
+	if( !overflowed )
+		entry = CacheEntry { f, g, h, result };
+
+	return result;
+}
+
+/* The cells are a truth table over all variables, cell a being the function value at
+ * address a. The table is split on its highest address bit, whole words that are all
+ * zero or all one end the recursion early.
+ */
+BddManager::Node BddManager::from_cells( const BitVector& cells )
+{
+	return build_cells( cells, no_of_variables, 0 );
+}
+
+BddManager::Node BddManager::build_cells( const BitVector& cells, unsigned int bits, uint64_t base )
+{
+	const std::vector<uint64_t>& words = cells.get_words();
+
+	if( bits <= 6 ) {
+		uint64_t word = (base >> 6) < words.size() ? words[base >> 6] >> (base & 63) : 0;
+
+		if( bits < 6 )
+			word &= (uint64_t(1) << (1u << bits)) - 1;
+
+		return build_word( word, bits );
+	}
+
+	size_t first = base >> 6;
+	size_t last = std::min<size_t>( first + (size_t(1) << (bits - 6)), words.size() );
+	bool all_set = true;
+	bool all_clear = true;
+
+	for( size_t index = first; (index < last) && (all_set || all_clear); ++index ) {
+		all_set = all_set && (words[index] == ~uint64_t(0));
+		all_clear = all_clear && (words[index] == 0);
+	}
+
+	if( all_clear )
+		return false_node;
+
+	if( all_set )
+		return true_node;
+
+	unsigned int split = bits - 1;
+	Node low = build_cells( cells, split, base );
+	Node high = build_cells( cells, split, base | (uint64_t(1) << split) );
+
+	return ite( variable( split ), high, low );
+}
+
+BddManager::Node BddManager::build_word( uint64_t word, unsigned int bits )
+{
+	uint64_t cell_mask = (bits < 6) ? (uint64_t(1) << (1u << bits)) - 1 : ~uint64_t(0);
+
+	if( word == 0 )
+		return false_node;
+
+	if( word == cell_mask )
+		return true_node;
+
+	unsigned int split = bits - 1;
+	unsigned int half = 1u << split;
+	Node low = build_word( word & ((uint64_t(1) << half) - 1), split );
+	Node high = build_word( word >> half, split );
+
+	return ite( variable( split ), high, low );
+}
+
+SolutionEntries BddManager::isop( Node lower, Node upper )
+{
+	std::map<std::pair<Node, Node>, IsopResult> memo;
+
+	return isop( lower, upper, memo ).cubes;
+}
+
+/* Minato-Morreale: the cubes that need the top variable at zero, those that need it at
+ * one, and a cover of what is left without the variable. Every cube ends up covering
+ * part of lower that no other cube covers, so the cover is irredundant.
+ */
+BddManager::IsopResult BddManager::isop( Node lower, Node upper, std::map<std::pair<Node, Node>, IsopResult>& memo )
+{
+	if( lower == false_node )
+		return IsopResult { false_node, SolutionEntries() };
+
+	if( upper == true_node )
+		return IsopResult { true_node, SolutionEntries( 1, SolutionEntry( 0, 0 ) ) };
+
+	auto found = memo.find( std::make_pair( lower, upper ) );
+
+	if( found != memo.end() )
+		return found->second;
+
+	unsigned int top = std::min( get_level( lower ), get_level( upper ) );
+	unsigned int bit = 1u << order[top];
+
+	Node lower0 = cofactor( lower, top, false );
+	Node lower1 = cofactor( lower, top, true );
+	Node upper0 = cofactor( upper, top, false );
+	Node upper1 = cofactor( upper, top, true );
+
+	IsopResult result0 = isop( apply_and( lower0, negate( upper1 ) ), upper0, memo );
+	IsopResult result1 = isop( apply_and( lower1, negate( upper0 ) ), upper1, memo );
+
+	Node rest = apply_or( apply_and( lower0, negate( result0.cover ) ), apply_and( lower1, negate( result1.cover ) ) );
+	IsopResult shared = isop( rest, apply_and( upper0, upper1 ), memo );
+
+	IsopResult result;
+
+	result.cover = apply_or( ite( variable( order[top] ), result1.cover, result0.cover ), shared.cover );
+
+	for( const SolutionEntry& cube : result0.cubes )
+		result.cubes.push_back( SolutionEntry( cube.GetMask() | bit, cube.GetNumber() ) );
+
+	for( const SolutionEntry& cube : result1.cubes )
+		result.cubes.push_back( SolutionEntry( cube.GetMask() | bit, cube.GetNumber() | bit ) );
+
+	result.cubes.insert( result.cubes.end(), shared.cubes.begin(), shared.cubes.end() );
+
+	memo[std::make_pair( lower, upper )] = result;
+
+	return result;
+}
+
+BddManager::Node BddManager::transfer( const BddManager& source, Node f, std::map<Node, Node>& copies )
+{
+	if( f <= true_node )
+		return f;
+
+	auto found = copies.find( f );
+
+	if( found != copies.end() )
+		return found->second;
+
+	const NodeData& node = source.nodes[f];
+	Node high = transfer( source, node.high, copies );
+	Node low = transfer( source, node.low, copies );
+	Node result = ite( variable( node.variable ), high, low );
+
+	copies[f] = result;
+
+	return result;
+}
+
+/* Copy the roots into a diagram with the new order, which then replaces this one
+ */
+void BddManager::rebuild( const std::vector<unsigned int>& new_order, std::vector<Node>& roots )
+{
+	BddManager target( no_of_variables, node_limit );
+	std::map<Node, Node> copies;
+
+	target.set_order( new_order );
+
+	for( Node& root : roots )
+		root = target.transfer( *this, root, copies );
+
+	*this = std::move( target );
+}
+
+void BddManager::collect_garbage( std::vector<Node>& roots )
+{
+	std::vector<unsigned int> same_order( order );
+
+	rebuild( same_order, roots );
+}
+
+/* Exchange the variables at level and level + 1 in place. A node of the upper variable
+ * that depends on the lower one is rewritten into a node of the lower variable over
+ * two new nodes of the upper one. It keeps its index and its function, so the roots,
+ * the nodes above it and the computed cache all stay valid. The nodes it no longer
+ * refers to remain in the array until the next garbage collection.
+ *
+ * Every node of the upper variable can need two new nodes. Returns false, leaving the
+ * order as it was, if there is no room for them even after collecting garbage.
+ */
+bool BddManager::swap_levels( unsigned int level, std::vector<Node>& roots )
+{
+	unsigned int upper = order[level];
+	unsigned int lower = order[level + 1];
+	std::vector<Node> moving;
+
+	for( unsigned int attempt = 0; attempt < 2; ++attempt ) {
+		moving.clear();
+
+		for( Node f = true_node + 1; f < nodes.size(); ++f )
+			if( nodes[f].variable == upper )
+				moving.push_back( f );
+
+		if( nodes.size() + 2 * moving.size() <= node_limit )
+			break;
+
+		if( attempt == 1 )
+			return false;
+
+		collect_garbage( roots );
+	}
+
+	for( Node f : moving ) {
+		Node f0 = nodes[f].low;
+		Node f1 = nodes[f].high;
+		bool split0 = nodes[f0].variable == lower;
+		bool split1 = nodes[f1].variable == lower;
+
+		if( !split0 && !split1 )
+			continue;
+
+		Node f00 = split0 ? nodes[f0].low : f0;
+		Node f01 = split0 ? nodes[f0].high : f0;
+		Node f10 = split1 ? nodes[f1].low : f1;
+		Node f11 = split1 ? nodes[f1].high : f1;
+
+		Node low = make_node( upper, f00, f10 );
+		Node high = make_node( upper, f01, f11 );
+
+		nodes[f] = NodeData { lower, low, high };
+	}
+
+	order[level] = lower;
+	order[level + 1] = upper;
+	levels[lower] = level;
+	levels[upper] = level + 1;
+
+	/* the rewritten nodes are still filed under their old variable and children
+	 */
+	fill_unique_table( unique_table.size() );
+
+	return true;
+}
+
+/* Rudell's sifting: every variable in turn is swapped down to the last level and up to
+ * the first, then back to the level where the roots had the fewest nodes.
+ */
+void BddManager::sift( std::vector<Node>& roots )
+{
+	std::vector<unsigned int> variables( order );
+
+	if( overflowed )
+		return;
+
+	collect_garbage( roots );
+
+	for( unsigned int current : variables ) {
+		unsigned int level = levels[current];
+		unsigned int best_level = level;
+		size_t best_size = count_nodes( roots );
+
+		for( ; (level + 1 < no_of_variables) && swap_levels( level, roots ); ++level ) {
+			size_t size = count_nodes( roots );
+
+			if( size < best_size ) {
+				best_size = size;
+				best_level = level + 1;
+			}
+		}
+
+		for( ; (level > 0) && swap_levels( level - 1, roots ); --level ) {
+			size_t size = count_nodes( roots );
+
+			if( size < best_size ) {
+				best_size = size;
+				best_level = level - 1;
+			}
+		}
+
+		while( (level < best_level) && swap_levels( level, roots ) )
+			++level;
+
+		while( (level > best_level) && swap_levels( level - 1, roots ) )
+			--level;
+
+		collect_garbage( roots );
+	}
+}
@@ -0,0 +1,132 @@
+/*
+ * Copyright 2024 Alwin Leerling <dna.leerling@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#ifndef BDDMANAGER_H
+#define BDDMANAGER_H
+
+#include <vector>
+#include <map>
+#include <cstddef>
+#include <cstdint>
+
+#include "solutionentry.h"
+#include "bitvector.h"
+
+/* Reduced ordered binary decision diagrams
+ *
+ * A node is an index into the node array, 0 and 1 are the constant functions. Nodes
+ * are made unique through a hash table keyed on (variable, low, high), so equal
+ * functions are equal indices. Every operation is an if-then-else whose results are
+ * kept in a fixed size computed cache.
+ *
+ * Variables are the address bits of a table, variable 0 being the lowest. Their order
+ * in the diagram is free: set_order before building, or sift to search for a smaller
+ * order. Sifting moves one variable at a time through every position by swapping
+ * adjacent levels in place, and keeps the position with the fewest nodes. Nodes are not
+ * reference counted, the ones no function uses anymore are dropped by collect_garbage,
+ * which copies the functions into a fresh diagram.
+ *
+ * The number of nodes is bounded. An operation that would exceed the bound returns
+ * the constant 0 and marks the manager as overflowed, after which its results are
+ * meaningless. Callers check is_overflowed once they are done.
+ *
+ * isop() extracts an irredundant sum of products between two functions with the
+ * Minato-Morreale recursion. Its cubes are SolutionEntries, which limits it to 32
+ * variables, the same as the truth table.
+ */
+class BddManager
+{
+public:
+	typedef unsigned int Node;
+
+	static const Node false_node = 0;
+	static const Node true_node = 1;
+	static const unsigned int max_variables = 32;
+	static const size_t default_node_limit = size_t(1) << 22;
+
+	explicit BddManager( unsigned int no_of_variables, size_t node_limit = default_node_limit );
+
+	unsigned int get_variable_count() const { return no_of_variables; }
+	const std::vector<unsigned int>& get_order() const { return order; }
+	void set_order( const std::vector<unsigned int>& new_order );
+
+	size_t get_node_count() const { return nodes.size(); }
+	size_t count_nodes( const std::vector<Node>& roots ) const;
+	bool is_overflowed() const { return overflowed; }
+
+	Node variable( unsigned int index );
+	Node ite( Node f, Node g, Node h );
+	Node negate( Node f ) { return ite( f, false_node, true_node ); }
+	Node apply_and( Node f, Node g ) { return ite( f, g, false_node ); }
+	Node apply_or( Node f, Node g ) { return ite( f, true_node, g ); }
+	Node apply_xor( Node f, Node g ) { return ite( f, negate( g ), g ); }
+
+	Node from_cells( const BitVector& cells );
+
+	SolutionEntries isop( Node lower, Node upper );
+
+	void collect_garbage( std::vector<Node>& roots );
+	void sift( std::vector<Node>& roots );
+
+private:
+	struct NodeData {
+		unsigned int variable;
+		Node low;
+		Node high;
+	};
+
+	struct CacheEntry {
+		Node f;
+		Node g;
+		Node h;
+		Node result;
+	};
+
+	struct IsopResult {
+		Node cover;
+		SolutionEntries cubes;
+	};
+
+	unsigned int no_of_variables;
+	size_t node_limit;
+	bool overflowed;
+
+	std::vector<unsigned int> order;			// variable at every level
+	std::vector<unsigned int> levels;			// level of every variable
+	std::vector<NodeData> nodes;
+	std::vector<Node> unique_table;				// open addressing, 0 marks an empty slot
+	std::vector<CacheEntry> computed_cache;
+
+	unsigned int get_level( Node f ) const { return (f <= true_node) ? no_of_variables : levels[nodes[f].variable]; }
+	Node cofactor( Node f, unsigned int level, bool value ) const;
+	Node make_node( unsigned int variable, Node low, Node high );
+	void grow_unique_table();
+	void fill_unique_table( size_t size );
+
+	Node build_cells( const BitVector& cells, unsigned int bits, uint64_t base );
+	Node build_word( uint64_t word, unsigned int bits );
+
+	IsopResult isop( Node lower, Node upper, std::map<std::pair<Node, Node>, IsopResult>& memo );
+
+	Node transfer( const BddManager& source, Node f, std::map<Node, Node>& copies );
+	void rebuild( const std::vector<unsigned int>& new_order, std::vector<Node>& roots );
+	bool swap_levels( unsigned int level, std::vector<Node>& roots );
+};
+
+#endif // BDDMANAGER_H
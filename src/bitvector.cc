@@ -0,0 +1,158 @@
+/*
+ * Copyright 2024 Alwin Leerling <dna.leerling@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#include "bitvector.h"
+
+#include <algorithm>
+#include <bitset>
+
+static unsigned int word_count( uint64_t word )
+{
+	return std::bitset<64>( word ).count();
+}
+
+static unsigned int lowest_bit( uint64_t word )
+{
+#if defined(__GNUC__)
+	return __builtin_ctzll( word );
+#else
+	unsigned int index = 0;
+
+	while( !(word & 1) ) {
+		word >>= 1;
+		++index;
+	}
+
+	return index;
+#endif
+}
+
+BitVector::BitVector( size_t size )
+{
+	resize( size );
+}
+
+void BitVector::resize( size_t size )
+{
+	no_of_bits = size;
+
+	bits.assign( (size + 63) / 64, 0 );
+}
+
+void BitVector::clear()
+{
+	std::fill( bits.begin(), bits.end(), 0 );
+}
+
+void BitVector::fill()
+{
+	std::fill( bits.begin(), bits.end(), ~uint64_t(0) );
+
+	if( no_of_bits & 63 )					// keep the unused bits of the last word clear
+		bits.back() = (uint64_t(1) << (no_of_bits & 63)) - 1;
+}
+
+size_t BitVector::count() const
+{
+	size_t result = 0;
+
+	for( uint64_t word : bits )
+		result += word_count( word );
+
+	return result;
+}
+
+size_t BitVector::count_common( const BitVector& rhs ) const
+{
+	size_t result = 0;
+
+	for( size_t index = 0; index < bits.size(); ++index )
+		result += word_count( bits[index] & rhs.bits[index] );
+
+	return result;
+}
+
+bool BitVector::none() const
+{
+	for( uint64_t word : bits )
+		if( word )
+			return false;
+
+	return true;
+}
+
+bool BitVector::intersects( const BitVector& rhs ) const
+{
+	for( size_t index = 0; index < bits.size(); ++index )
+		if( bits[index] & rhs.bits[index] )
+			return true;
+
+	return false;
+}
+
+bool BitVector::is_subset_of( const BitVector& rhs ) const
+{
+	for( size_t index = 0; index < bits.size(); ++index )
+		if( bits[index] & ~rhs.bits[index] )
+			return false;
+
+	return true;
+}
+
+size_t BitVector::find_next( size_t index ) const
+{
+	if( index >= no_of_bits )
+		return npos;
+
+	size_t word_index = index >> 6;
+	uint64_t word = bits[word_index] & (~uint64_t(0) << (index & 63));
+
+	while( !word ) {
+		if( ++word_index == bits.size() )
+			return npos;
+
+		word = bits[word_index];
+	}
+
+	return (word_index << 6) + lowest_bit( word );
+}
+
+BitVector& BitVector::operator&=( const BitVector& rhs )
+{
+	for( size_t index = 0; index < bits.size(); ++index )
+		bits[index] &= rhs.bits[index];
+
+	return *this;
+}
+
+BitVector& BitVector::operator|=( const BitVector& rhs )
+{
+	for( size_t index = 0; index < bits.size(); ++index )
+		bits[index] |= rhs.bits[index];
+
+	return *this;
+}
+
+BitVector& BitVector::remove( const BitVector& rhs )
+{
+	for( size_t index = 0; index < bits.size(); ++index )
+		bits[index] &= ~rhs.bits[index];
+
+	return *this;
+}
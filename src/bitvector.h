@@ -0,0 +1,72 @@
+/*
+ * Copyright 2024 Alwin Leerling <dna.leerling@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#ifndef BITVECTOR_H
+#define BITVECTOR_H
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+/* Fixed size set of bits stored in 64 bit words.
+ * All whole set operations work a word at a time.
+ */
+class BitVector
+{
+public:
+	static const size_t npos = static_cast<size_t>( -1 );
+
+	BitVector() : no_of_bits( 0 ) {}
+	explicit BitVector( size_t size );
+
+	void resize( size_t size );
+	void clear();
+	void fill();
+
+	size_t size() const { return no_of_bits; }
+
+	void set( size_t index ) { bits[index >> 6] |= uint64_t(1) << (index & 63); }
+	void reset( size_t index ) { bits[index >> 6] &= ~(uint64_t(1) << (index & 63)); }
+	bool test( size_t index ) const { return (bits[index >> 6] >> (index & 63)) & 1; }
+
+	size_t count() const;
+	size_t count_common( const BitVector& rhs ) const;
+	bool none() const;
+	bool intersects( const BitVector& rhs ) const;
+	bool is_subset_of( const BitVector& rhs ) const;
+
+	size_t find_first() const { return find_next( 0 ); }
+	size_t find_next( size_t index ) const;
+
+	BitVector& operator&=( const BitVector& rhs );
+	BitVector& operator|=( const BitVector& rhs );
+	BitVector& remove( const BitVector& rhs );
+
+	bool operator==( const BitVector& rhs ) const { return bits == rhs.bits; }
+	bool operator!=( const BitVector& rhs ) const { return bits != rhs.bits; }
+
+	const std::vector<uint64_t>& get_words() const { return bits; }
+	std::vector<uint64_t>& get_words() { return bits; }
+
+private:
+	size_t no_of_bits;
+	std::vector<uint64_t> bits;
+};
+
+#endif // BITVECTOR_H
@@ -0,0 +1,88 @@
+/*
+ * Copyright 2024 Alwin Leerling <dna.leerling@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#ifndef BOUNDEDQUEUE_H
+#define BOUNDEDQUEUE_H
+
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <cstddef>
+
+/* Queue between threads holding at most capacity items
+ *
+ * push waits while the queue is full, pop while it is empty. After close every push
+ * fails and pop drains what is left, then fails as well, which ends the consumers.
+ */
+template<typename T>
+class BoundedQueue
+{
+public:
+	explicit BoundedQueue( size_t capacity ) : capacity( capacity ? capacity : 1 ), closed( false ) {}
+
+	bool push( T item )
+	{
+		std::unique_lock<std::mutex> lock( mutex );
+
+		not_full.wait( lock, [this]() { return closed || (items.size() < capacity); } );
+
+		if( closed )
+			return false;
+
+		items.push_back( std::move( item ) );
+		not_empty.notify_one();
+
+		return true;
+	}
+
+	bool pop( T& item )
+	{
+		std::unique_lock<std::mutex> lock( mutex );
+
+		not_empty.wait( lock, [this]() { return closed || !items.empty(); } );
+
+		if( items.empty() )
+			return false;
+
+		item = std::move( items.front() );
+		items.pop_front();
+		not_full.notify_one();
+
+		return true;
+	}
+
+	void close()
+	{
+		std::lock_guard<std::mutex> lock( mutex );
+
+		closed = true;
+		not_full.notify_all();
+		not_empty.notify_all();
+	}
+
+private:
+	std::deque<T> items;
+	size_t capacity;
+	bool closed;
+	std::mutex mutex;
+	std::condition_variable not_full;
+	std::condition_variable not_empty;
+};
+
+#endif // BOUNDEDQUEUE_H
@@ -0,0 +1,456 @@
+/*
+ * Copyright 2024 Alwin Leerling <dna.leerling@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#include "coversolver.h"
+
+#include <algorithm>
+#include <bitset>
+#include <climits>
+#include <memory>
+
+/* Petrick's method multiplies out a product of sums, the number of product terms can
+ * explode. It is only tried on small charts, and once the number of terms grows beyond
+ * the limit we fall back on the branch and bound search.
+ */
+static const unsigned int petrick_row_limit = 32;
+static const unsigned int petrick_term_limit = 256;
+
+void SharedBound::offer( unsigned int terms, unsigned int literals )
+{
+	uint64_t offered = pack( terms, literals );
+	uint64_t current = cost.load( std::memory_order_relaxed );
+
+	while( (offered < current) && !cost.compare_exchange_weak( current, offered, std::memory_order_relaxed ) )
+		;
+}
+
+CoverSolver::CoverSolver( const PrimeChart& chart, SharedBound * bound, ThreadPool * pool ) : chart( chart ), bound( bound ), pool( pool )
+{
+	statistics = CoverStatistics { false, 0, 0, false };
+	node_limit = 0;
+	solve_limit = nullptr;
+	base_terms = 0;
+	base_literals = 0;
+	buffers = nullptr;
+	best_terms = UINT_MAX;
+	best_literals = UINT_MAX;
+}
+
+const std::vector<unsigned int>& CoverSolver::solve()
+{
+	const ChartState& state = chart.get_state();
+
+	if( !buffers ) {
+		own_buffers.reset( new SearchBuffers );
+		buffers = own_buffers.get();
+	}
+
+	std::vector<unsigned int>& rows = buffers->rows;
+	std::vector<unsigned int>& result = buffers->cover;
+
+	statistics = CoverStatistics { false, 0, 0, false };
+	rows.clear();
+	buffers->best_rows.clear();
+	best_terms = UINT_MAX;
+	best_literals = UINT_MAX;
+
+	base_terms = state.selected_rows.size();
+	base_literals = 0;
+	for( unsigned int row : state.selected_rows )
+		base_literals += chart.get_row_cost( row );
+
+	for( size_t row = state.active_rows.find_first(); row != BitVector::npos; row = state.active_rows.find_next( row + 1 ) )
+		rows.push_back( row );
+
+	if( !state.active_columns.none() ) {
+		statistics.used_petrick = (rows.size() <= petrick_row_limit) && solve_petrick( rows, state.active_columns );
+
+		if( !statistics.used_petrick )
+			solve_branch_and_bound( state );
+	} else
+		record( buffers->best_rows, 0 );
+
+	result.assign( state.selected_rows.begin(), state.selected_rows.end() );
+	result.insert( result.end(), buffers->best_rows.begin(), buffers->best_rows.end() );
+	std::sort( result.begin(), result.end() );
+
+	return result;
+}
+
+bool CoverSolver::is_better( unsigned int terms, unsigned int literals ) const
+{
+	return (terms < best_terms) || ( (terms == best_terms) && (literals < best_literals) );
+}
+
+bool CoverSolver::solve_petrick( const std::vector<unsigned int>& rows, const BitVector& columns )
+{
+	std::vector<uint64_t>& terms = buffers->terms;
+	std::vector<uint64_t>& next_terms = buffers->next_terms;
+
+	terms.assign( 1, 0 );
+
+	auto term_size = []( uint64_t term ) { return std::bitset<64>( term ).count(); };
+
+	/* Every column gives a sum of the rows covering it, the product of all these sums
+	 * is multiplied out one column at a time. A term that already contains one of the
+	 * rows of the sum is left as is (x(x+y) = x), supersets of other terms are absorbed.
+	 */
+	for( size_t column = columns.find_first(); column != BitVector::npos; column = columns.find_next( column + 1 ) ) {
+
+		uint64_t sum = 0;
+
+		for( unsigned int index = 0; index < rows.size(); ++index )
+			if( chart.get_column( column ).test( rows[index] ) )
+				sum |= uint64_t(1) << index;
+
+		next_terms.clear();
+
+		for( uint64_t term : terms ) {
+			if( term & sum ) {
+				next_terms.push_back( term );
+				continue;
+			}
+
+			for( uint64_t remaining = sum; remaining; remaining &= remaining - 1 )
+				next_terms.push_back( term | (remaining & (~remaining + 1)) );
+		}
+
+		std::sort( next_terms.begin(), next_terms.end(), [&]( uint64_t lhs, uint64_t rhs )
+						{ return (term_size(lhs) != term_size(rhs)) ? term_size(lhs) < term_size(rhs) : lhs < rhs; } );
+		next_terms.erase( std::unique( next_terms.begin(), next_terms.end() ), next_terms.end() );
+
+		terms.clear();
+
+		for( uint64_t term : next_terms )
+			if( std::none_of( terms.begin(), terms.end(), [term]( uint64_t kept ) { return (kept & term) == kept; } ) )
+				terms.push_back( term );
+
+		statistics.petrick_terms = std::max<unsigned long>( statistics.petrick_terms, terms.size() );
+
+		if( terms.size() > petrick_term_limit )
+			return false;
+	}
+
+	for( uint64_t term : terms ) {
+
+		unsigned int literals = 0;
+
+		for( unsigned int index = 0; index < rows.size(); ++index )
+			if( term & (uint64_t(1) << index) )
+				literals += chart.get_row_cost( rows[index] );
+
+		if( is_better( term_size( term ), literals ) ) {
+			std::vector<unsigned int>& term_rows = buffers->term_rows;
+
+			term_rows.clear();
+			for( unsigned int index = 0; index < rows.size(); ++index )
+				if( term & (uint64_t(1) << index) )
+					term_rows.push_back( rows[index] );
+
+			record( term_rows, literals );
+		}
+	}
+
+	return true;
+}
+
+void CoverSolver::record( const std::vector<unsigned int>& rows, unsigned int literals )
+{
+	buffers->best_rows = rows;
+	best_terms = rows.size();
+	best_literals = literals;
+
+	if( bound )
+		bound->offer( base_terms + best_terms, base_literals + best_literals );
+}
+
+void CoverSolver::solve_branch_and_bound( const ChartState& state )
+{
+	SharedBound local_bound;
+
+	/* The concurrent branches only learn about each others covers through a bound
+	 */
+	if( pool && !bound )
+		bound = &local_bound;
+
+	greedy_cover( state );
+
+	/* the search works on the rows it adds itself, the ones already selected stay out of it
+	 */
+	if( buffers->states.empty() )
+		buffers->states.emplace_back();
+
+	ChartState& root = buffers->states.front();
+
+	root.active_rows = state.active_rows;
+	root.active_columns = state.active_columns;
+	root.selected_rows.clear();
+
+	if( pool )
+		search_branches( root );
+	else
+		branch( root, 0, 0 );
+
+	if( bound == &local_bound )
+		bound = nullptr;
+}
+
+void CoverSolver::search_branches( ChartState& root )
+{
+	std::vector<std::unique_ptr<CoverSolver>> searches;
+	std::vector<unsigned int> rows;
+	unsigned int literals = 0;
+
+	if( !expand_node( root, literals, rows ) )
+		return;
+
+	/* Every branch of the root is an independent search with its own best cover, they
+	 * only share the bound. Going through the results in branch order and keeping the
+	 * first of equal covers gives the same answer as long as all branches have finished,
+	 * however they were scheduled.
+	 */
+	for( unsigned int row : rows ) {
+		ChartState child( root );
+
+		child.selected_rows.push_back( row );
+		child.active_rows.reset( row );
+		child.active_columns.remove( chart.get_row( row ) );
+
+		root.active_rows.reset( row );
+
+		searches.emplace_back( new CoverSolver( chart, bound ) );
+
+		CoverSolver * search = searches.back().get();
+		unsigned int child_literals = literals + chart.get_row_cost( row );
+
+		search->own_buffers.reset( new SearchBuffers );
+		search->buffers = search->own_buffers.get();
+		search->node_limit = node_limit;
+		search->solve_limit = solve_limit;
+		search->base_terms = base_terms;
+		search->base_literals = base_literals;
+
+		pool->submit( [search, child, child_literals]() mutable { search->branch( child, child_literals, 0 ); } );
+	}
+
+	pool->wait();
+
+	for( const std::unique_ptr<CoverSolver>& search : searches ) {
+		statistics.search_nodes += search->statistics.search_nodes;
+		statistics.search_truncated = statistics.search_truncated || search->statistics.search_truncated;
+
+		if( (search->best_terms != UINT_MAX) && is_better( search->best_terms, search->best_literals ) ) {
+			buffers->best_rows = search->buffers->best_rows;
+			best_terms = search->best_terms;
+			best_literals = search->best_literals;
+		}
+	}
+}
+
+void CoverSolver::greedy_cover( const ChartState& state )
+{
+	BitVector& uncovered = buffers->uncovered;
+	std::vector<unsigned int>& rows = buffers->rows;
+	unsigned int literals = 0;
+
+	uncovered = state.active_columns;
+	rows.clear();
+
+	/* keep taking the row covering most of what is left, this gives the search its first bound
+	 */
+	while( !uncovered.none() ) {
+		unsigned int best_row = 0;
+		size_t best_count = 0;
+
+		for( size_t row = state.active_rows.find_first(); row != BitVector::npos; row = state.active_rows.find_next( row + 1 ) ) {
+			size_t count = chart.get_row( row ).count_common( uncovered );
+
+			if( (count > best_count) || ( (count == best_count) && (count != 0) && (chart.get_row_cost( row ) < chart.get_row_cost( best_row )) ) ) {
+				best_count = count;
+				best_row = row;
+			}
+		}
+
+		if( best_count == 0 )			// nothing left that can be covered
+			break;
+
+		rows.push_back( best_row );
+		literals += chart.get_row_cost( best_row );
+		uncovered.remove( chart.get_row( best_row ) );
+	}
+
+	record( rows, literals );
+}
+
+void CoverSolver::branch( ChartState& state, unsigned int literals, size_t depth )
+{
+	while( buffers->states.size() < depth + 2 )
+		buffers->states.emplace_back();
+
+	while( buffers->branch_rows.size() < depth + 1 )
+		buffers->branch_rows.emplace_back();
+
+	std::vector<unsigned int>& rows = buffers->branch_rows[depth];
+	ChartState& child = buffers->states[depth + 1];
+
+	rows.clear();
+
+	if( !expand_node( state, literals, rows ) )
+		return;
+
+	/* One of the rows covering the hardest to cover column has to be in the cover.
+	 * Try them all, most promising first. Once a row has been tried every cover containing
+	 * it has been seen, so the branches that follow leave it out.
+	 */
+	for( unsigned int row : rows ) {
+		child = state;
+
+		child.selected_rows.push_back( row );
+		child.active_rows.reset( row );
+		child.active_columns.remove( chart.get_row( row ) );
+
+		branch( child, literals + chart.get_row_cost( row ), depth + 1 );
+
+		state.active_rows.reset( row );
+	}
+}
+
+bool CoverSolver::expand_node( ChartState& state, unsigned int& literals, std::vector<unsigned int>& rows )
+{
+	ReductionStatistics reduction = ReductionStatistics { 0, 0, 0, 0, 0, 0, 0 };
+	size_t selected = state.selected_rows.size();
+
+	/* Past a limit the best cover so far stands, there is at least the greedy one
+	 */
+	if( (node_limit && (statistics.search_nodes >= node_limit)) || (solve_limit && solve_limit->is_reached()) ) {
+		statistics.search_truncated = true;
+		return false;
+	}
+
+	++statistics.search_nodes;
+
+	/* Every subproblem is reduced the same way as the whole chart was
+	 */
+	chart.reduce( state, reduction, buffers->reduction );
+
+	for( size_t index = selected; index < state.selected_rows.size(); ++index )
+		literals += chart.get_row_cost( state.selected_rows[index] );
+
+	if( state.active_columns.none() ) {
+		if( is_better( state.selected_rows.size(), literals ) )
+			record( state.selected_rows, literals );
+		return false;
+	}
+
+	unsigned int bound_terms;
+	unsigned int bound_literals;
+	unsigned int column;
+
+	if( !lower_bound( state, bound_terms, bound_literals, column ) )
+		return false;
+
+	bound_terms += state.selected_rows.size();
+	bound_literals += literals;
+
+	if( (bound_terms > best_terms) || ( (bound_terms == best_terms) && (bound_literals >= best_literals) ) )
+		return false;
+
+	if( bound && !bound->admits( base_terms + bound_terms, base_literals + bound_literals ) )
+		return false;
+
+	/* the candidates are the rows covering the hardest to cover column
+	 */
+	BitVector& candidates = buffers->candidates;
+	std::vector<size_t>& gains = buffers->gains;
+
+	candidates = chart.get_column( column );
+	candidates &= state.active_rows;
+
+	for( size_t row = candidates.find_first(); row != BitVector::npos; row = candidates.find_next( row + 1 ) )
+		rows.push_back( row );
+
+	if( gains.size() < chart.get_row_count() )
+		gains.resize( chart.get_row_count() );
+
+	for( unsigned int row : rows )
+		gains[row] = chart.get_row( row ).count_common( state.active_columns );
+
+	/* the row number as the last key keeps equal rows in order without the buffer of a
+	 * stable sort
+	 */
+	std::sort( rows.begin(), rows.end(), [&]( unsigned int lhs, unsigned int rhs ) {
+		if( gains[lhs] != gains[rhs] )
+			return gains[lhs] > gains[rhs];
+
+		return (chart.get_row_cost( lhs ) != chart.get_row_cost( rhs )) ? chart.get_row_cost( lhs ) < chart.get_row_cost( rhs ) : lhs < rhs;
+	} );
+
+	return true;
+}
+
+bool CoverSolver::lower_bound( const ChartState& state, unsigned int& terms, unsigned int& literals, unsigned int& column ) const
+{
+	std::vector<std::pair<size_t, unsigned int>>& degrees = buffers->degrees;
+	BitVector& used_rows = buffers->used_rows;
+	BitVector& available = buffers->available;
+
+	degrees.clear();
+	used_rows.resize( chart.get_row_count() );
+
+	terms = 0;
+	literals = 0;
+
+	for( size_t index = state.active_columns.find_first(); index != BitVector::npos; index = state.active_columns.find_next( index + 1 ) ) {
+		size_t degree = chart.get_column( index ).count_common( state.active_rows );
+
+		if( degree == 0 )					// this column can not be covered anymore
+			return false;
+
+		degrees.push_back( std::make_pair( degree, index ) );
+	}
+
+	std::sort( degrees.begin(), degrees.end() );
+
+	column = degrees.front().second;
+
+	/* Columns that have no row in common each need a row of their own, so the size of
+	 * any such set of columns is a lower bound on the rows still needed. Likewise the sum
+	 * of the cheapest row of each of these columns bounds the literals still needed.
+	 * Starting with the hardest to cover columns tends to give the largest set.
+	 */
+	for( const std::pair<size_t, unsigned int>& degree : degrees ) {
+
+		available = chart.get_column( degree.second );
+		available &= state.active_rows;
+
+		if( available.intersects( used_rows ) )
+			continue;
+
+		used_rows |= available;
+		++terms;
+
+		unsigned int cheapest = UINT_MAX;
+		for( size_t row = available.find_first(); row != BitVector::npos; row = available.find_next( row + 1 ) )
+			cheapest = std::min( cheapest, chart.get_row_cost( row ) );
+
+		literals += cheapest;
+	}
+
+	return true;
+}
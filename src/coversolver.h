@@ -0,0 +1,146 @@
+/*
+ * Copyright 2024 Alwin Leerling <dna.leerling@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#ifndef COVERSOLVER_H
+#define COVERSOLVER_H
+
+#include <vector>
+#include <deque>
+#include <memory>
+#include <cstdint>
+#include <utility>
+#include <atomic>
+
+#include "primechart.h"
+#include "threadpool.h"
+#include "solvelimit.h"
+
+struct CoverStatistics
+{
+	bool used_petrick;					// true if Petrick's method solved the chart
+	unsigned long petrick_terms;		// largest intermediate sum of products
+	unsigned long search_nodes;			// nodes visited by the branch and bound search
+	bool search_truncated;				// true if the node or solve limit stopped the search, the cover may not be minimal
+};
+
+/* Cost of the best cover found so far, shared between concurrent searches
+ *
+ * Terms and literals are packed in one word, terms in the high half, so the lexicographic
+ * cost order is plain integer order and the bound can be lowered with a single atomic.
+ * A search drops a branch only when it is strictly worse than the bound, ties are always
+ * searched to the end. That keeps the outcome independent of the order in which the
+ * concurrent searches happen to lower the bound.
+ */
+class SharedBound
+{
+public:
+	SharedBound() : cost( UINT64_MAX ) {}
+
+	bool admits( unsigned int terms, unsigned int literals ) const { return pack( terms, literals ) <= cost.load( std::memory_order_relaxed ); }
+	void offer( unsigned int terms, unsigned int literals );
+
+private:
+	std::atomic<uint64_t> cost;
+
+	static uint64_t pack( unsigned int terms, unsigned int literals ) { return (uint64_t(terms) << 32) | literals; }
+};
+
+/* Memory of a cover search
+ *
+ * The solver takes its temporaries from here, a node of the search takes the state and
+ * the rows of its depth. Given the same buffers again it overwrites them, once they have
+ * seen the largest chart and the deepest search a solve does not allocate anymore. The
+ * levels are deques, growing them keeps the nodes further up the search where they are.
+ * One set of buffers serves one search at a time.
+ */
+struct SearchBuffers
+{
+	std::deque<ChartState> states;					// per depth
+	std::deque<std::vector<unsigned int>> branch_rows;	// per depth
+	std::vector<size_t> gains;						// per row
+	std::vector<std::pair<size_t, unsigned int>> degrees;	// rows left to cover a column, column
+	BitVector candidates;
+	BitVector used_rows;
+	BitVector available;
+	BitVector uncovered;
+	std::vector<unsigned int> rows;					// Petrick's method and the greedy cover
+	std::vector<unsigned int> term_rows;
+	std::vector<uint64_t> terms;
+	std::vector<uint64_t> next_terms;
+	std::vector<unsigned int> best_rows;
+	std::vector<unsigned int> cover;				// what solve() returns
+	ReductionBuffers reduction;
+};
+
+/* Exact minimum cover of a prime implicant chart
+ *
+ * The cover minimises the number of rows, ties are broken by the total row cost.
+ * Small charts are solved with Petrick's method, if that blows up (or the chart has too
+ * many rows to represent a product as a 64 bit set) a branch and bound search is used.
+ * Every subproblem of the search is reduced like the chart itself before branching.
+ *
+ * Given a thread pool the branches below the root are searched concurrently. Each branch
+ * keeps its own best cover and the winner is picked in branch order, so the result does
+ * not depend on the number of threads. The branches allocate their own buffers.
+ *
+ * Without buffers given by set_buffers() the solver allocates a set for itself.
+ *
+ * A node limit or a solve limit ends the search early with the best cover found so far,
+ * at worst the greedy one it starts from.
+ */
+class CoverSolver
+{
+public:
+	explicit CoverSolver( const PrimeChart& chart, SharedBound * bound = nullptr, ThreadPool * pool = nullptr );
+
+	const std::vector<unsigned int>& solve();
+	void set_node_limit( unsigned long limit ) { node_limit = limit; }
+	void set_solve_limit( const SolveLimit * limit ) { solve_limit = limit; }
+	void set_buffers( SearchBuffers * search_buffers ) { buffers = search_buffers; }
+
+	const CoverStatistics& get_statistics() const { return statistics; }
+
+private:
+	const PrimeChart& chart;
+	SharedBound * bound;
+	ThreadPool * pool;
+	CoverStatistics statistics;
+	unsigned long node_limit;				// 0 searches without limit
+	const SolveLimit * solve_limit;			// none searches until done
+
+	unsigned int base_terms;				// rows selected before the search started
+	unsigned int base_literals;
+
+	SearchBuffers * buffers;				// best_rows is part of them
+	std::unique_ptr<SearchBuffers> own_buffers;
+	unsigned int best_terms;
+	unsigned int best_literals;
+
+	bool solve_petrick( const std::vector<unsigned int>& rows, const BitVector& columns );
+	void solve_branch_and_bound( const ChartState& state );
+	void greedy_cover( const ChartState& state );
+	void search_branches( ChartState& root );
+	void branch( ChartState& state, unsigned int literals, size_t depth );
+	bool expand_node( ChartState& state, unsigned int& literals, std::vector<unsigned int>& rows );
+	void record( const std::vector<unsigned int>& rows, unsigned int literals );
+	bool lower_bound( const ChartState& state, unsigned int& terms, unsigned int& literals, unsigned int& column ) const;
+	bool is_better( unsigned int terms, unsigned int literals ) const;
+};
+
+#endif // COVERSOLVER_H
@@ -0,0 +1,73 @@
+/*
+ * Copyright 2024 Alwin Leerling <dna.leerling@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#include "coververifier.h"
+
+bool CoverVerifier::verify( const SolutionEntries& cover, const BitVector& lower, const BitVector& upper )
+{
+	SolutionEntry::GetCoverage( cover, lower.size(), coverage );
+
+	error_address = BitVector::npos;
+
+	for( size_t index = 0; index < coverage.get_words().size(); ++index )
+		if( !check_word( index, lower.get_words()[index], upper.get_words()[index] ) )
+			return false;
+
+	return true;
+}
+
+/* The bounds are read straight off the words of the table, nothing is built for them
+ */
+bool CoverVerifier::verify( const SolutionEntries& cover, const TruthTable& table, bool zeros )
+{
+	SolutionEntry::GetCoverage( cover, table.size(), coverage );
+
+	error_address = BitVector::npos;
+
+	for( size_t index = 0; index < table.get_word_count(); ++index ) {
+		uint64_t lower = zeros ? table.get_zero_word( index ) : table.get_one_word( index );
+		uint64_t upper = lower | table.get_dontcare_word( index );
+
+		if( !check_word( index, lower, upper ) )
+			return false;
+	}
+
+	return true;
+}
+
+bool CoverVerifier::check_word( size_t index, uint64_t lower, uint64_t upper )
+{
+	uint64_t word = coverage.get_words()[index];
+	uint64_t missing = lower & ~word;
+	uint64_t extra = word & ~upper;
+
+	if( !(missing | extra) )
+		return true;
+
+	uint64_t wrong = missing | extra;
+	unsigned int bit = 0;
+
+	while( !((wrong >> bit) & 1) )
+		++bit;
+
+	error_missing = (missing >> bit) & 1;
+	error_address = (uint64_t(index) << 6) + bit;
+
+	return false;
+}
@@ -0,0 +1,60 @@
+/*
+ * Copyright 2024 Alwin Leerling <dna.leerling@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#ifndef COVERVERIFIER_H
+#define COVERVERIFIER_H
+
+#include <cstdint>
+
+#include "solutionentry.h"
+#include "bitvector.h"
+#include "truthtable.h"
+
+/* Checks that a cover is a correct one
+ *
+ * A cover is correct when it holds every cell it has to (the lower bound) and no cell
+ * outside the ones it may (the upper bound): lower <= cover <= upper. For a sum of
+ * products the lower bound is the ON-set and the upper bound the ON-set with the don't
+ * cares, for a product of sums the same with the zeros.
+ *
+ * The cover is written into a bit set by SolutionEntry::GetCoverage, both bounds are then
+ * compared with it 64 cells at a time. The bit set is kept for the next check, so after
+ * the first one checking allocates nothing. The lowest wrong cell is kept to tell what
+ * went wrong.
+ */
+class CoverVerifier
+{
+public:
+	CoverVerifier() : error_address( BitVector::npos ), error_missing( false ) {}
+
+	bool verify( const SolutionEntries& cover, const BitVector& lower, const BitVector& upper );
+	bool verify( const SolutionEntries& cover, const TruthTable& table, bool zeros );
+
+	uint64_t get_error_address() const { return error_address; }		// BitVector::npos if the cover was correct
+	bool is_error_missing() const { return error_missing; }				// the cell was left out, otherwise it is covered but should not be
+
+private:
+	BitVector coverage;
+	uint64_t error_address;
+	bool error_missing;
+
+	bool check_word( size_t index, uint64_t lower, uint64_t upper );
+};
+
+#endif // COVERVERIFIER_H
@@ -0,0 +1,328 @@
+/*
+ * Copyright 2024 Alwin Leerling <dna.leerling@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#include "espresso.h"
+
+#include <algorithm>
+#include <bitset>
+#include <cstdint>
+
+static unsigned int bit_count( unsigned int number )
+{
+	return std::bitset<32>( number ).count();
+}
+
+static bool intersects( const SolutionEntry& lhs, const SolutionEntry& rhs )
+{
+	return ( (lhs.GetNumber() ^ rhs.GetNumber()) & lhs.GetMask() & rhs.GetMask() ) == 0;
+}
+
+static bool contains( const SolutionEntry& outer, const SolutionEntry& inner )
+{
+	return ( (outer.GetMask() & ~inner.GetMask()) == 0 ) && ( ((outer.GetNumber() ^ inner.GetNumber()) & outer.GetMask()) == 0 );
+}
+
+static unsigned int cover_literals( const SolutionEntries& cover )
+{
+	unsigned int literals = 0;
+
+	for( const SolutionEntry& cube : cover )
+		literals += cube.GetLiteralCount();
+
+	return literals;
+}
+
+Espresso::Espresso( unsigned int no_of_inputs )
+{
+	this->no_of_inputs = no_of_inputs;
+	iterations = 0;
+	solve_limit = nullptr;
+	stopped = false;
+}
+
+SolutionEntries Espresso::minimise( const SolutionEntries& on_set, const SolutionEntries& dc_set, const SolutionEntries& off_set )
+{
+	SolutionEntries cover( on_set );
+
+	dontcares = dc_set;
+	offset = off_set;
+	iterations = 0;
+	stopped = false;
+
+	expand( cover );
+	irredundant( cover );
+
+	/* Keep going for as long as a REDUCE / EXPAND / IRREDUNDANT pass gives a cheaper cover
+	 */
+	while( true ) {
+		if( is_limit_reached() ) {
+			stopped = true;
+			break;
+		}
+
+		SolutionEntries candidate( cover );
+
+		++iterations;
+
+		reduce( candidate );
+		expand( candidate );
+		irredundant( candidate );
+
+		bool fewer_cubes = candidate.size() < cover.size();
+		bool fewer_literals = (candidate.size() == cover.size()) && (cover_literals( candidate ) < cover_literals( cover ));
+
+		if( !fewer_cubes && !fewer_literals )
+			break;
+
+		cover.swap( candidate );
+	}
+
+	return cover;
+}
+
+bool Espresso::hits_offset( const SolutionEntry& cube ) const
+{
+	for( const SolutionEntry& off : offset )
+		if( intersects( cube, off ) )
+			return true;
+
+	return false;
+}
+
+void Espresso::expand( SolutionEntries& cover ) const
+{
+	std::vector<bool> covered( cover.size(), false );
+
+	/* Largest cubes first, they are the most likely to swallow the others
+	 */
+	std::stable_sort( cover.begin(), cover.end(), []( const SolutionEntry& lhs, const SolutionEntry& rhs )
+						{ return lhs.GetLiteralCount() < rhs.GetLiteralCount(); } );
+
+	for( unsigned int index = 0; index < cover.size(); ++index ) {
+
+		if( covered[index] )
+			continue;
+
+		/* the cubes not expanded yet stay in the cover as they are
+		 */
+		if( is_limit_reached() )
+			break;
+
+		cover[index] = expand_cube( cover[index], cover, covered );
+
+		for( unsigned int other = 0; other < cover.size(); ++other )
+			if( (other != index) && !covered[other] && contains( cover[index], cover[other] ) )
+				covered[other] = true;
+	}
+
+	SolutionEntries result;
+
+	for( unsigned int index = 0; index < cover.size(); ++index )
+		if( !covered[index] )
+			result.push_back( cover[index] );
+
+	cover.swap( result );
+}
+
+SolutionEntry Espresso::expand_cube( const SolutionEntry& cube, const SolutionEntries& cover, const std::vector<bool>& covered ) const
+{
+	std::vector<std::pair<unsigned int, unsigned int>> literals;		// number of cubes this literal keeps out, literal
+
+	/* Raise first the literals that stand between this cube and most of the other cubes,
+	 * that way the expanded cube tends to cover as many of them as possible
+	 */
+	for( unsigned int literal = cube.GetMask(); literal; literal &= literal - 1 ) {
+		unsigned int bit = literal & (~literal + 1);
+		unsigned int blocked = 0;
+
+		for( unsigned int index = 0; index < cover.size(); ++index )
+			if( !covered[index] && ( !(cover[index].GetMask() & bit) || ((cover[index].GetNumber() ^ cube.GetNumber()) & bit) ) )
+				++blocked;
+
+		literals.push_back( std::make_pair( blocked, bit ) );
+	}
+
+	std::stable_sort( literals.begin(), literals.end(), []( const std::pair<unsigned int, unsigned int>& lhs, const std::pair<unsigned int, unsigned int>& rhs )
+						{ return lhs.first > rhs.first; } );
+
+	SolutionEntry result( cube );
+
+	for( const std::pair<unsigned int, unsigned int>& literal : literals ) {
+		SolutionEntry raised( result.GetMask() & ~literal.second, result.GetNumber() & ~literal.second );
+
+		if( !hits_offset( raised ) )
+			result = raised;
+	}
+
+	return result;
+}
+
+void Espresso::irredundant( SolutionEntries& cover ) const
+{
+	std::vector<bool> removed( cover.size(), false );
+	std::vector<unsigned int> order( cover.size() );
+
+	for( unsigned int index = 0; index < cover.size(); ++index )
+		order[index] = index;
+
+	/* Try to get rid of the smallest cubes first
+	 */
+	std::stable_sort( order.begin(), order.end(), [&cover]( unsigned int lhs, unsigned int rhs )
+						{ return cover[lhs].GetLiteralCount() > cover[rhs].GetLiteralCount(); } );
+
+	for( unsigned int index : order ) {
+		if( is_limit_reached() )		// the cubes not tried yet stay
+			break;
+
+		removed[index] = true;
+
+		if( !is_covered( cover[index], cover, removed ) )
+			removed[index] = false;
+	}
+
+	SolutionEntries result;
+
+	for( unsigned int index = 0; index < cover.size(); ++index )
+		if( !removed[index] )
+			result.push_back( cover[index] );
+
+	cover.swap( result );
+}
+
+void Espresso::reduce( SolutionEntries& cover ) const
+{
+	std::vector<bool> skip( cover.size(), false );
+	unsigned int variables = (no_of_inputs < 32) ? (1u << no_of_inputs) - 1 : ~0u;
+
+	/* Shrink one cube at a time, every later cube sees the already reduced ones.
+	 * A cube can lose the half along a free variable if the rest of the cover
+	 * (and the don't cares) already covers that half.
+	 */
+	for( unsigned int index = 0; index < cover.size(); ++index ) {
+
+		skip[index] = true;
+
+		for( unsigned int free = variables & ~cover[index].GetMask(); free; free &= free - 1 ) {
+			unsigned int bit = free & (~free + 1);
+
+			SolutionEntry low( cover[index].GetMask() | bit, cover[index].GetNumber() );
+			SolutionEntry high( cover[index].GetMask() | bit, cover[index].GetNumber() | bit );
+
+			if( is_covered( high, cover, skip ) )
+				cover[index] = low;
+			else if( is_covered( low, cover, skip ) )
+				cover[index] = high;
+		}
+
+		skip[index] = false;
+	}
+}
+
+bool Espresso::is_covered( const SolutionEntry& cube, const SolutionEntries& cover, const std::vector<bool>& skip ) const
+{
+	SolutionEntries cofactor;
+	unsigned int variables = ( (no_of_inputs < 32) ? (1u << no_of_inputs) - 1 : ~0u ) & ~cube.GetMask();
+
+	/* A cube is covered by a cover if the cofactor of the cover with respect to the cube is a tautology
+	 */
+	auto add_cofactor = [&]( const SolutionEntry& entry ) {
+		if( intersects( entry, cube ) ) {
+			unsigned int mask = entry.GetMask() & ~cube.GetMask();
+			cofactor.push_back( SolutionEntry( mask, entry.GetNumber() & mask ) );
+		}
+	};
+
+	for( unsigned int index = 0; index < cover.size(); ++index )
+		if( !skip[index] )
+			add_cofactor( cover[index] );
+
+	for( const SolutionEntry& entry : dontcares )
+		add_cofactor( entry );
+
+	return tautology( cofactor, variables );
+}
+
+bool Espresso::tautology( const SolutionEntries& cubes, unsigned int variables ) const
+{
+	unsigned int ones[32] = { 0 };
+	unsigned int zeros[32] = { 0 };
+	uint64_t cells = 0;
+
+	/* A cube without literals covers everything. If the cubes together hold fewer cells
+	 * than the space they live in there must be a hole somewhere
+	 */
+	for( const SolutionEntry& cube : cubes ) {
+		if( cube.GetMask() == 0 )
+			return true;
+
+		cells += uint64_t(1) << bit_count( variables & ~cube.GetMask() );
+
+		for( unsigned int literal = cube.GetMask(); literal; literal &= literal - 1 ) {
+			unsigned int variable = bit_count( (literal & (~literal + 1)) - 1 );
+
+			if( cube.GetNumber() & (1u << variable) )
+				++ones[variable];
+			else
+				++zeros[variable];
+		}
+	}
+
+	if( cells < (uint64_t(1) << bit_count( variables )) )
+		return false;
+
+	/* Split on the most binate variable. If the cover is unate in that variable only
+	 * the half without the literal needs checking: the other half holds a superset of its cubes
+	 */
+	unsigned int split = 0;
+	unsigned int best_binate = 0;
+	unsigned int best_total = 0;
+
+	for( unsigned int variable = 0; variable < 32; ++variable ) {
+		unsigned int binate = std::min( ones[variable], zeros[variable] );
+		unsigned int total = ones[variable] + zeros[variable];
+
+		if( (binate > best_binate) || ( (binate == best_binate) && (total > best_total) ) ) {
+			best_binate = binate;
+			best_total = total;
+			split = variable;
+		}
+	}
+
+	unsigned int bit = 1u << split;
+
+	auto cofactor = [&]( unsigned int value ) {
+		SolutionEntries result;
+
+		for( const SolutionEntry& cube : cubes )
+			if( !(cube.GetMask() & bit) )
+				result.push_back( cube );
+			else if( (cube.GetNumber() & bit) == value )
+				result.push_back( SolutionEntry( cube.GetMask() & ~bit, cube.GetNumber() & ~bit ) );
+
+		return result;
+	};
+
+	if( zeros[split] == 0 )
+		return tautology( cofactor( 0 ), variables & ~bit );
+
+	if( ones[split] == 0 )
+		return tautology( cofactor( bit ), variables & ~bit );
+
+	return tautology( cofactor( 0 ), variables & ~bit ) && tautology( cofactor( bit ), variables & ~bit );
+}
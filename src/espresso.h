@@ -0,0 +1,73 @@
+/*
+ * Copyright 2024 Alwin Leerling <dna.leerling@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#ifndef ESPRESSO_H
+#define ESPRESSO_H
+
+#include <vector>
+
+#include "solutionentry.h"
+#include "solvelimit.h"
+
+/* Heuristic two level minimiser in the style of Espresso
+ *
+ * Works on covers: lists of cubes stored as SolutionEntry (mask holds the variables that
+ * take part, number their value). The ON-set cover is improved by repeating
+ *	EXPAND		make every cube prime by raising literals as long as it does not hit the OFF-set
+ *	IRREDUNDANT	drop cubes covered by the rest of the cover and the don't cares
+ *	REDUCE		shrink every cube to what only it covers, to let the next EXPAND find other primes
+ * for as long as the cover gets cheaper. Each step is polynomial in the size of the covers,
+ * containment checks are done with the unate recursive tautology check.
+ *
+ * Every cube of the cover stays inside the ON-set and don't cares throughout, so a solve
+ * limit can end the minimisation at any pass, or halfway an EXPAND or IRREDUNDANT, with a
+ * valid cover.
+ */
+class Espresso
+{
+public:
+	explicit Espresso( unsigned int no_of_inputs );
+
+	SolutionEntries minimise( const SolutionEntries& on_set, const SolutionEntries& dc_set, const SolutionEntries& off_set );
+
+	void set_solve_limit( const SolveLimit * limit ) { solve_limit = limit; }
+
+	unsigned int get_iterations() const { return iterations; }
+	bool is_stopped() const { return stopped; }		// the solve limit ended the last minimisation
+
+private:
+	unsigned int no_of_inputs;
+	unsigned int iterations;
+	const SolveLimit * solve_limit;
+	bool stopped;
+	SolutionEntries dontcares;
+	SolutionEntries offset;
+
+	bool is_limit_reached() const { return solve_limit && solve_limit->is_reached(); }
+	void expand( SolutionEntries& cover ) const;
+	void irredundant( SolutionEntries& cover ) const;
+	void reduce( SolutionEntries& cover ) const;
+
+	SolutionEntry expand_cube( const SolutionEntry& cube, const SolutionEntries& cover, const std::vector<bool>& covered ) const;
+	bool hits_offset( const SolutionEntry& cube ) const;
+	bool is_covered( const SolutionEntry& cube, const SolutionEntries& cover, const std::vector<bool>& skip ) const;
+	bool tautology( const SolutionEntries& cubes, unsigned int variables ) const;
+};
+
+#endif // ESPRESSO_H
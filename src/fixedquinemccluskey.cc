@@ -0,0 +1,169 @@
+/*
+ * Copyright 2024 Alwin Leerling <dna.leerling@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#include "fixedquinemccluskey.h"
+
+#include <bitset>
+
+static unsigned int lowest_bit( uint64_t word )
+{
+#if defined(__GNUC__)
+	return __builtin_ctzll( word );
+#else
+	unsigned int index = 0;
+
+	while( !(word & 1) ) {
+		word >>= 1;
+		++index;
+	}
+
+	return index;
+#endif
+}
+
+/* Cells of one word with the given variable zero, for the variables inside a word
+ */
+static constexpr uint64_t low_half[6] = {
+	0x5555555555555555ULL, 0x3333333333333333ULL, 0x0F0F0F0F0F0F0F0FULL,
+	0x00FF00FF00FF00FFULL, 0x0000FFFF0000FFFFULL, 0x00000000FFFFFFFFULL
+};
+
+/* Cubes with variable free, from the cubes without: the cube at a (variable zero in a)
+ * needs both a and a with the variable set
+ */
+template<unsigned int Inputs>
+typename FixedQuineMcCluskey<Inputs>::CellSet FixedQuineMcCluskey<Inputs>::combine( const CellSet& cells, unsigned int variable )
+{
+	CellSet result;
+
+	if( variable < 6 ) {
+		for( unsigned int index = 0; index < no_of_words; ++index )
+			result[index] = cells[index] & (cells[index] >> (1u << variable)) & low_half[variable];
+	} else {
+		unsigned int distance = 1u << (variable - 6);
+
+		for( unsigned int index = 0; index < no_of_words; ++index )
+			result[index] = (index & distance) ? 0 : cells[index] & cells[index | distance];
+	}
+
+	return result;
+}
+
+/* The reverse: mark both halves of every cube with variable free
+ */
+template<unsigned int Inputs>
+void FixedQuineMcCluskey<Inputs>::expand( const CellSet& cells, unsigned int variable, CellSet& result )
+{
+	if( variable < 6 ) {
+		for( unsigned int index = 0; index < no_of_words; ++index )
+			result[index] |= cells[index] | (cells[index] << (1u << variable));
+	} else {
+		unsigned int distance = 1u << (variable - 6);
+
+		for( unsigned int index = 0; index < no_of_words; ++index )
+			if( !(index & distance) ) {
+				result[index] |= cells[index];
+				result[index | distance] |= cells[index];
+			}
+	}
+}
+
+template<unsigned int Inputs>
+void FixedQuineMcCluskey<Inputs>::find_prime_implicants( const std::vector<unsigned int>& addresses, SolutionEntries& primes )
+{
+	primes.clear();
+
+	cubes[0].fill( 0 );
+	for( unsigned int address : addresses )
+		cubes[0][address >> 6] |= uint64_t(1) << (address & 63);
+
+	/* Each set of free variables builds on the set without its lowest variable
+	 */
+	for( unsigned int free = 1; free < no_of_cells; ++free ) {
+		unsigned int variable = lowest_bit( free );
+
+		cubes[free] = combine( cubes[free & (free - 1)], variable );
+	}
+
+	/* Fewer free variables means a larger mask, walking the sets from the top gives the
+	 * primes ordered by mask and within a mask by number
+	 */
+	for( unsigned int free = no_of_cells; free-- > 0; ) {
+		CellSet absorbed;
+
+		absorbed.fill( 0 );
+
+		for( unsigned int variable = 0; variable < Inputs; ++variable )
+			if( !(free & (1u << variable)) )
+				expand( cubes[free | (1u << variable)], variable, absorbed );
+
+		for( unsigned int index = 0; index < no_of_words; ++index ) {
+			uint64_t word = cubes[free][index] & ~absorbed[index];
+
+			while( word ) {
+				primes.push_back( SolutionEntry( variable_mask & ~free, (index << 6) + lowest_bit( word ) ) );
+				word &= word - 1;
+			}
+		}
+	}
+}
+
+template<unsigned int Inputs>
+void FixedQuineMcCluskey<Inputs>::count( SolverStatistics& statistics ) const
+{
+	for( unsigned int free = 1; free < no_of_cells; ++free )
+		for( unsigned int index = 0; index < no_of_words; ++index )
+			statistics.merges += std::bitset<64>( cubes[free][index] ).count();
+}
+
+template class FixedQuineMcCluskey<1>;
+template class FixedQuineMcCluskey<2>;
+template class FixedQuineMcCluskey<3>;
+template class FixedQuineMcCluskey<4>;
+template class FixedQuineMcCluskey<5>;
+template class FixedQuineMcCluskey<6>;
+template class FixedQuineMcCluskey<7>;
+template class FixedQuineMcCluskey<8>;
+
+template<unsigned int Inputs>
+static void run_fixed( const std::vector<unsigned int>& addresses, SolutionEntries& primes, SolverStatistics * statistics )
+{
+	FixedQuineMcCluskey<Inputs> engine;
+
+	engine.find_prime_implicants( addresses, primes );
+
+	if( statistics )
+		engine.count( *statistics );
+}
+
+bool find_fixed_prime_implicants( unsigned int no_of_inputs, const std::vector<unsigned int>& addresses, SolutionEntries& primes,
+									SolverStatistics * statistics )
+{
+	switch( no_of_inputs ) {
+	case 1: run_fixed<1>( addresses, primes, statistics ); return true;
+	case 2: run_fixed<2>( addresses, primes, statistics ); return true;
+	case 3: run_fixed<3>( addresses, primes, statistics ); return true;
+	case 4: run_fixed<4>( addresses, primes, statistics ); return true;
+	case 5: run_fixed<5>( addresses, primes, statistics ); return true;
+	case 6: run_fixed<6>( addresses, primes, statistics ); return true;
+	case 7: run_fixed<7>( addresses, primes, statistics ); return true;
+	case 8: run_fixed<8>( addresses, primes, statistics ); return true;
+	default: return false;
+	}
+}
@@ -0,0 +1,73 @@
+/*
+ * Copyright 2024 Alwin Leerling <dna.leerling@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#ifndef FIXEDQUINEMCCLUSKEY_H
+#define FIXEDQUINEMCCLUSKEY_H
+
+#include <vector>
+#include <array>
+#include <cstdint>
+
+#include "solutionentry.h"
+#include "solverstatistics.h"
+
+/* Prime implicant generation for a number of inputs known at compile time
+ *
+ * Instead of combining implicants pair by pair every set of free variables gets one
+ * bit set over the table: bit a is set when the cube through address a with those
+ * variables free lies entirely in the function. Freeing one more variable v is an AND
+ * of that set with itself shifted by v, and a cube is prime when none of the sets one
+ * free variable up absorbs it. With the table size and the variable masks constant
+ * the compiler unrolls and vectorises all of it.
+ *
+ * Every implicant is made exactly once, count() adds the cubes found with one or more
+ * free variables as merges. Pairs are not compared one by one, so there is nothing to
+ * count as comparisons or duplicates.
+ *
+ * The primes come out in the same order as QuineMcCluskey returns them.
+ * Instantiated for 1 to 8 inputs, the range the exact solvers handle. Above that the
+ * 2^n sets of 2^n bits grow too large to be worth it.
+ */
+template<unsigned int Inputs>
+class FixedQuineMcCluskey
+{
+public:
+	static constexpr unsigned int no_of_cells = 1u << Inputs;
+	static constexpr unsigned int no_of_words = (no_of_cells + 63) / 64;
+	static constexpr unsigned int variable_mask = no_of_cells - 1;
+
+	typedef std::array<uint64_t, no_of_words> CellSet;
+
+	void find_prime_implicants( const std::vector<unsigned int>& addresses, SolutionEntries& primes );
+	void count( SolverStatistics& statistics ) const;
+
+private:
+	std::array<CellSet, no_of_cells> cubes;		// indexed by the set of free variables
+
+	static CellSet combine( const CellSet& cells, unsigned int variable );
+	static void expand( const CellSet& cells, unsigned int variable, CellSet& result );
+};
+
+/* Runs the instantiation for no_of_inputs, returns false if there is none. Counts into
+ * statistics if given.
+ */
+bool find_fixed_prime_implicants( unsigned int no_of_inputs, const std::vector<unsigned int>& addresses, SolutionEntries& primes,
+									SolverStatistics * statistics = nullptr );
+
+#endif // FIXEDQUINEMCCLUSKEY_H
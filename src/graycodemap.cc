@@ -0,0 +1,46 @@
+/*
+ * Copyright 2024 Alwin Leerling <dna.leerling@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#include "graycodemap.h"
+
+GrayCodeMap::GrayCodeMap()
+{
+	set_dimension( 0 );
+}
+
+void GrayCodeMap::set_dimension( unsigned int no_of_inputs )
+{
+	/* the rows take the high half of the address, the columns the (possibly larger) low half
+	 */
+	col_bits = (no_of_inputs + 1) / 2;
+
+	build( no_of_inputs / 2, row_codes, row_indices );
+	build( col_bits, col_codes, col_indices );
+}
+
+void GrayCodeMap::build( unsigned int bits, std::vector<unsigned int>& codes, std::vector<unsigned int>& indices )
+{
+	codes.resize( 1u << bits );
+	indices.resize( 1u << bits );
+
+	for( unsigned int index = 0; index < codes.size(); ++index ) {
+		codes[index] = gray_encode( index );
+		indices[codes[index]] = index;
+	}
+}
@@ -0,0 +1,57 @@
+/*
+ * Copyright 2024 Alwin Leerling <dna.leerling@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#ifndef GRAYCODEMAP_H
+#define GRAYCODEMAP_H
+
+#include <vector>
+
+/* Mapping between Karnaugh map cells and table addresses
+ *
+ * The row and column of a cell are Gray coded into the high and low half of its
+ * address. Both directions are looked up in tables per half, built by set_dimension,
+ * so neither needs to search the grid.
+ */
+class GrayCodeMap
+{
+public:
+	GrayCodeMap();
+
+	void set_dimension( unsigned int no_of_inputs );
+
+	unsigned int get_row_count() const { return row_codes.size(); }
+	unsigned int get_col_count() const { return col_codes.size(); }
+
+	unsigned int get_address( unsigned int row, unsigned int col ) const { return (row_codes[row] << col_bits) | col_codes[col]; }
+	unsigned int get_row( unsigned int address ) const { return row_indices[address >> col_bits]; }
+	unsigned int get_col( unsigned int address ) const { return col_indices[address & (get_col_count() - 1)]; }
+
+	static unsigned int gray_encode( unsigned int number ) { return number ^ (number >> 1); }
+
+private:
+	unsigned int col_bits;
+	std::vector<unsigned int> row_codes;		// Gray code of every row, the inverse in row_indices
+	std::vector<unsigned int> row_indices;
+	std::vector<unsigned int> col_codes;
+	std::vector<unsigned int> col_indices;
+
+	static void build( unsigned int bits, std::vector<unsigned int>& codes, std::vector<unsigned int>& indices );
+};
+
+#endif // GRAYCODEMAP_H
@@ -0,0 +1,115 @@
+/*
+ * Copyright 2024 Alwin Leerling <dna.leerling@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#include "implicantstore.h"
+
+#include <algorithm>
+#include <numeric>
+#include <bitset>
+
+void ImplicantStore::clear()
+{
+	masks.clear();
+	numbers.clear();
+	marks.clear();
+}
+
+void ImplicantStore::reserve( size_t size )
+{
+	masks.reserve( size );
+	numbers.reserve( size );
+	marks.reserve( (size + 63) / 64 );
+}
+
+void ImplicantStore::push_back( unsigned int mask, unsigned int number )
+{
+	if( (masks.size() & 63) == 0 )
+		marks.push_back( 0 );
+
+	masks.push_back( mask );
+	numbers.push_back( number );
+}
+
+void ImplicantStore::swap( ImplicantStore& other )
+{
+	masks.swap( other.masks );
+	numbers.swap( other.numbers );
+	marks.swap( other.marks );
+}
+
+void ImplicantStore::sort_unique()
+{
+	unsigned int used_bits = 0;
+
+	for( unsigned int number : numbers )
+		used_bits |= number;
+
+	/* With numbers of up to 26 bits the whole order fits in one 64 bit key: mask, ones
+	 * count, number. Sorting those directly is a lot faster than sorting through an index.
+	 */
+	if( used_bits < (1U << 26) ) {
+		keys.resize( size() );
+
+		for( size_t index = 0; index < size(); ++index )
+			keys[index] = (uint64_t( masks[index] ) << 32) | (uint64_t( std::bitset<32>( numbers[index] ).count() ) << 26) | numbers[index];
+
+		std::sort( keys.begin(), keys.end() );
+		keys.erase( std::unique( keys.begin(), keys.end() ), keys.end() );
+
+		masks.resize( keys.size() );
+		numbers.resize( keys.size() );
+
+		for( size_t index = 0; index < keys.size(); ++index ) {
+			masks[index] = keys[index] >> 32;
+			numbers[index] = keys[index] & ((1U << 26) - 1);
+		}
+	} else {
+		std::vector<uint32_t> ones( size() );
+		std::vector<size_t> order( size() );
+		std::vector<unsigned int> sorted_masks;
+		std::vector<unsigned int> sorted_numbers;
+
+		for( size_t index = 0; index < size(); ++index )
+			ones[index] = std::bitset<32>( numbers[index] ).count();
+
+		std::iota( order.begin(), order.end(), 0 );
+		std::sort( order.begin(), order.end(), [this, &ones]( size_t lhs, size_t rhs ) {
+			if( masks[lhs] != masks[rhs] )
+				return masks[lhs] < masks[rhs];
+
+			return (ones[lhs] != ones[rhs]) ? ones[lhs] < ones[rhs] : numbers[lhs] < numbers[rhs];
+		} );
+
+		sorted_masks.reserve( size() );
+		sorted_numbers.reserve( size() );
+
+		for( size_t index : order ) {
+			if( !sorted_masks.empty() && (sorted_masks.back() == masks[index]) && (sorted_numbers.back() == numbers[index]) )
+				continue;
+
+			sorted_masks.push_back( masks[index] );
+			sorted_numbers.push_back( numbers[index] );
+		}
+
+		masks.swap( sorted_masks );
+		numbers.swap( sorted_numbers );
+	}
+
+	marks.assign( (masks.size() + 63) / 64, 0 );
+}
@@ -0,0 +1,68 @@
+/*
+ * Copyright 2024 Alwin Leerling <dna.leerling@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#ifndef IMPLICANTSTORE_H
+#define IMPLICANTSTORE_H
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+#include "solutionentry.h"
+
+/* Implicants stored as separate arrays of masks and numbers
+ *
+ * The tabulation runs one implicant along the numbers of a bucket, which keeps that
+ * scan on one contiguous array. Whether an implicant has been combined is kept in a
+ * bitmap next to the arrays instead of in the implicant.
+ *
+ * Sorting puts the implicants in level order: by mask, then by the number of ones in
+ * the number, then by number. That groups every mask and, within it, every ones count.
+ * The sort keys are kept between calls, so a reused store stops allocating once it has
+ * held its largest level.
+ */
+class ImplicantStore
+{
+public:
+	ImplicantStore() {}
+
+	void clear();
+	void reserve( size_t size );
+	void push_back( unsigned int mask, unsigned int number );
+	void swap( ImplicantStore& other );
+	void sort_unique();
+
+	size_t size() const { return masks.size(); }
+	bool empty() const { return masks.empty(); }
+
+	unsigned int get_mask( size_t index ) const { return masks[index]; }
+	unsigned int get_number( size_t index ) const { return numbers[index]; }
+	SolutionEntry get_entry( size_t index ) const { return SolutionEntry( masks[index], numbers[index] ); }
+
+	void mark( size_t index ) { marks[index >> 6] |= uint64_t(1) << (index & 63); }
+	bool is_marked( size_t index ) const { return (marks[index >> 6] >> (index & 63)) & 1; }
+
+private:
+	std::vector<unsigned int> masks;
+	std::vector<unsigned int> numbers;
+	std::vector<uint64_t> marks;
+	std::vector<uint64_t> keys;
+};
+
+#endif // IMPLICANTSTORE_H
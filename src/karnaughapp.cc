@@ -21,9 +21,15 @@
 
 #include "karnaughwindow.h"
 #include "karnaughconfig.h"
+#include "tracer.h"
 
 IMPLEMENT_APP( KarnaughApp )
 
+/* The solver runs on the GUI thread, a pathological table must not freeze the window.
+ * Past this the best cover found so far is shown.
+ */
+static const std::chrono::milliseconds solver_budget( 2000 );
+
 KarnaughApp::KarnaughApp() : wxApp()
 {
 	data = nullptr;
@@ -37,6 +43,7 @@ bool KarnaughApp::OnInit()
 	data = new KarnaughData;
 
 	data->set_dimension( config->GetInputs() );
+	data->set_thread_count( config->GetThreads() );
 
 	CreateGUI();
 
@@ -64,6 +71,7 @@ void KarnaughApp::CreateGUI()
 
 	frame->SetNewShowAddress( config->GetShowAddress() );
     frame->SetNewShowZeroes( config->GetShowZeroes() );
+	frame->SetNewTracing( Tracer::is_enabled() );
 
     unsigned int no_of_inputs = config->GetInputs();
 
@@ -151,9 +159,16 @@ void KarnaughApp::SetNewShowZeroes( bool on )
 
 void KarnaughApp::RunSolver( )
 {
+	TraceSpan span( "KarnaughApp::RunSolver" );
+
 	frame->PreSolver( );
 
-    SolutionEntries solutions = data->find_best_solution();
+	SolverStatistics statistics;
+	SolveLimit limit;
+
+	limit.set_budget( solver_budget );
+
+    SolutionEntries solutions = data->find_best_solution( limit, statistics );
 
 	frame->PostSolverStart( data->get_solution_type() == KarnaughData::SOP, solutions.size() );
 
@@ -163,7 +178,23 @@ void KarnaughApp::RunSolver( )
 		++id;
 	}
 
-	frame->PostSolverFinish();
+	frame->PostSolverFinish( statistics, data->is_solve_stopped() );
+}
+
+void KarnaughApp::SetTracing( bool on )
+{
+	Tracer::set_enabled( on );
+}
+
+void KarnaughApp::SaveTrace()
+{
+	wxString file_name = frame->GetTraceFileName();
+
+	if( file_name.empty() )
+		return;
+
+	if( !Tracer::write( std::string( file_name.mb_str() ) ) )
+		frame->SetStatusText( _( "The trace could not be written" ) );
 }
 
 void KarnaughApp::SetSolutionSelection( unsigned int index )
@@ -42,6 +42,8 @@ public:
 	void SetNewSolutionType( KarnaughData::eSolutionType type );
 	void SetNewShowAddress( bool on );
 	void SetNewShowZeroes( bool on );
+	void SetTracing( bool on );
+	void SaveTrace();
 
 protected:
     virtual bool OnInit();
@@ -100,6 +100,22 @@ void KarnaughConfig::SetSolutionType( KarnaughData::eSolutionType type )
 	config.Flush();
 }
 
+int KarnaughConfig::GetThreads()
+{
+	int threads;
+
+    if( ! config.Read( "Threads", &threads ) || (threads < 0) )
+		return 0;
+
+	return threads;
+}
+
+void KarnaughConfig::SetThreads( int threads )
+{
+	config.Write( "Threads", threads );
+	config.Flush();
+}
+
 void KarnaughConfig::GetInstalledLanguages( )
 {
     wxString name = wxLocale::GetLanguageName( wxLANGUAGE_DEFAULT );
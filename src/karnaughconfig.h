@@ -39,11 +39,13 @@ public:
     void SetShowAddress( bool on );
     void SetInputs( int inputs );
     void SetSolutionType( KarnaughData::eSolutionType type );
+    void SetThreads( int threads );
 
     bool GetShowZeroes();
     bool GetShowAddress();
     int GetInputs();
     KarnaughData::eSolutionType GetSolutionType();
+    int GetThreads();
 
 	wxArrayString GetLanguages( );
 	void SetNewLocale( long index );
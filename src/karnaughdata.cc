@@ -19,81 +19,125 @@
 
 #include "karnaughdata.h"
 
-#include <functional>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 
 #include "solutionentry.h"
+#include "quinemccluskey.h"
+#include "fixedquinemccluskey.h"
+#include "primechart.h"
+#include "espresso.h"
+#include "bddmanager.h"
 
 KarnaughData::KarnaughData()
 {
 	no_of_inputs = 0;
-	table.resize( 1 << 8, ZERO );
+	table.resize( 0 );
 	solution_type = SOP;
+	solver_mode = TABULAR;
+	thread_count = 0;
+	primes_current = false;
+	cover_statistics = CoverStatistics { false, 0, 0, false };
+	reduction_statistics = ReductionStatistics { 0, 0, 0, 0, 0, 0, 0 };
 	the_solution.clear();
-
+	verification_failures = 0;
+	statistics_enabled = false;
+	solver_statistics.clear();
+	solve_limit = nullptr;
+	solve_stopped = false;
+	solution_optimal = false;
 }
 
 void KarnaughData::set_value( unsigned int address, KarnaughData::eCellValues new_value )
 {
-	if( address > (unsigned int)(1 << no_of_inputs) )
+	if( address >= table.size() )
 		return;
 
-	table[address] = new_value;
+	eCellValues old_value = get_value( address );
+
+	switch( new_value ) {
+	case ONE: table.set_one( address ); break;
+	case DONTCARE: table.set_dontcare( address ); break;
+	default: table.set_zero( address ); break;
+	}
+
+	update_prime_implicants( address, old_value, new_value );
+}
+
+KarnaughData::eCellValues KarnaughData::get_value( unsigned int address ) const
+{
+	if( table.is_dontcare( address ) )
+		return DONTCARE;
+
+	return table.is_one( address ) ? ONE : ZERO;
 }
 
 void KarnaughData::set_dimension( unsigned int no_of_inputs )
 {
-	if( no_of_inputs > 8 )
-		no_of_inputs = 8;
+	if( no_of_inputs > max_inputs )
+		no_of_inputs = max_inputs;
 
 	this->no_of_inputs = no_of_inputs;
 
-	std::fill( table.begin(), table.end(), ZERO );
+	table.resize( no_of_inputs );
+	grid_map.set_dimension( no_of_inputs );
+	primes_current = false;
+}
+
+/* Replaces dimension and contents in one go, for loading whole functions
+ */
+void KarnaughData::set_table( const TruthTable& new_table )
+{
+	no_of_inputs = new_table.get_no_of_inputs();
+
+	table = new_table;
+	grid_map.set_dimension( no_of_inputs );
+	primes_current = false;
 }
 
 void KarnaughData::set_solution_type( eSolutionType type )
 {
 	solution_type = type;
+	primes_current = false;
 }
 
-unsigned int KarnaughData::calc_address( unsigned int row, unsigned int col )
+void KarnaughData::set_solver_mode( eSolverMode mode )
 {
-	return ( gray_encode(row) << ((no_of_inputs + 1) / 2) ) + gray_encode(col);
+	solver_mode = mode;
+	primes_current = false;
 }
 
-GridAddress KarnaughData::calc_address( unsigned int address )
+void KarnaughData::set_thread_count( unsigned int count )
 {
-	for( int row = 0; row < (1 << (no_of_inputs / 2)); ++row )
-		for( int col = 0; col < (1 << ((no_of_inputs + 1) / 2)); ++col )
-			if( calc_address( row, col ) == address )
-				return GridAddress( row, col );
-
-	return InvalidGridAddress;
+	thread_count = count;
+	pool.reset();
 }
 
-unsigned int KarnaughData::gray_encode( unsigned int number )
+ThreadPool& KarnaughData::get_thread_pool()
 {
-	return number ^ (number >> 1);
+	if( !pool )
+		pool.reset( new ThreadPool( thread_count ) );
+
+	return *pool;
 }
 
-std::vector<unsigned int> KarnaughData::number_to_binaryvector( unsigned int code, unsigned int length )
+unsigned int KarnaughData::calc_address( unsigned int row, unsigned int col )
 {
-	if( length == 0 )
-		length = 1;
-
-    std::vector<unsigned int> result;
-	result.resize( length, 0 );
+	return grid_map.get_address( row, col );
+}
 
-	for( int i = length; i > 0; --i ) {
-		result[i-1] = code % 2;
-		code /= 2;
-	}
+GridAddress KarnaughData::calc_address( unsigned int address )
+{
+	if( address >= table.size() )
+		return InvalidGridAddress;
 
-	return result;
+	return GridAddress( grid_map.get_row( address ), grid_map.get_col( address ) );
 }
 
 std::string KarnaughData::index_to_greycode_string( unsigned int index, unsigned int length )
 {
-	unsigned int gray_code = gray_encode(index);
+	unsigned int gray_code = GrayCodeMap::gray_encode(index);
 
 	if( length == 0 )
 		length = 1;
@@ -109,60 +153,248 @@ std::string KarnaughData::index_to_greycode_string( unsigned int index, unsigned
 	return result;
 }
 
-void KarnaughData::find_solution( std::list<SolutionEntry>& solutions )
+uint64_t KarnaughData::count_cells( eCellValues value ) const
 {
-	for( std::list<SolutionEntry>::iterator it = solutions.begin(); it != solutions.end(); ++it ) {
-		for( std::list<SolutionEntry>::iterator it2 = std::next( it, 1); it2 != solutions.end(); ++it2 ) {
+	switch( value ) {
+	case ONE: return table.count_ones();
+	case DONTCARE: return table.count_dontcares();
+	default: return table.count_zeros();
+	}
+}
 
-			// filter out duplicates
-			if( *it == *it2 ) {
-				(*it).MarkForDeletion();
-				break;
-			}
+uint64_t KarnaughData::get_word( eCellValues value, size_t index ) const
+{
+	switch( value ) {
+	case ONE: return table.get_one_word( index );
+	case DONTCARE: return table.get_dontcare_word( index );
+	default: return table.get_zero_word( index );
+	}
+}
 
-			if( (*it).MaskEqual( *it2 ) ) {
-				unsigned int xor_number = (*it).ComputeXOR( *it2);
-
-				/* Using Brian Kernighan’s Algorithm to check that there is one and only one bit in a a number
-				 * If one bit and only one bit is set in a number it must be a multiple of 2.
-				 * If you deduct 1 you create a mask for the lower order bits.
-				 * if you AND the original number with that mask the result should be zero.
-				 * if the result is non zero, there must be a one in the lower order bits, thus we have more
-				 * than one bit set
-				 */
-				if( (xor_number != 0) && ( (xor_number & (xor_number - 1)) == 0) ) {
-					solutions.push_back( (*it).ComputeNewEntry( xor_number ) );
-					(*it).MarkForDeletion();
-					(*it2).MarkForDeletion();
-				}
-			}
+void KarnaughData::collect_addresses( eCellValues value, std::vector<unsigned int>& addresses ) const
+{
+	addresses.reserve( count_cells( value ) );
 
-		}
+	for( size_t index = 0; index < table.get_word_count(); ++index ) {
+		uint64_t word = get_word( value, index );
+
+		for( unsigned int bit = 0; word; ++bit, word >>= 1 )
+			if( word & 1 )
+				addresses.push_back( (index << 6) + bit );
 	}
+}
+
+/* The exact solvers only run up to exact_input_limit inputs, every table size up to there
+ * has an instantiation of its own
+ */
+void KarnaughData::find_prime_implicants( const std::vector<unsigned int>& addresses, SolutionEntries& primes, SolverStatistics * statistics ) const
+{
+	PhaseTimer timer( statistics, SolverStatistics::TABULATION );
 
-	solutions.remove_if(  std::function<bool( const SolutionEntry& )>( [](const SolutionEntry& rhs) { return rhs.IsDeleted(); } )  );
+	find_fixed_prime_implicants( no_of_inputs, addresses, primes, statistics );
 }
 
-SolutionEntries KarnaughData::find_best_solution( )
+BitVector KarnaughData::function_set( eCellValues target ) const
 {
-	std::list<SolutionEntry> solutions;
-	std::vector<unsigned int> dontcares;
-	std::list<SolutionEntry> best_solution;
+	BitVector addresses( table.size() );
 
-	the_solution.clear();
+	for( size_t index = 0; index < table.get_word_count(); ++index )
+		addresses.get_words()[index] = get_word( target, index ) | get_word( DONTCARE, index );
 
-	/* fill list with maxterms ( minterms if POS )
+	return addresses;
+}
+
+void KarnaughData::update_prime_implicants( unsigned int address, eCellValues old_value, eCellValues new_value )
+{
+	eCellValues target = (solution_type == POS) ? ZERO : ONE;
+	bool was_included = (old_value == target) || (old_value == DONTCARE);
+	bool is_included = (new_value == target) || (new_value == DONTCARE);
+
+	/* The primes are those of the targets and don't cares together, a cell moving
+	 * between these two leaves them as they are
 	 */
-	unsigned int mask = (1 << no_of_inputs) - 1;
+	if( !primes_current || (was_included == is_included) )
+		return;
+
+	QuineMcCluskey engine( no_of_inputs );
+
+	if( is_included )
+		engine.insert_address( prime_implicants, function_set( target ), address );
+	else
+		engine.erase_address( prime_implicants, address );
+}
+
+std::vector<uint64_t> KarnaughData::cache_key() const
+{
+	std::vector<uint64_t> key;
 
-	for( int address = 0; address < (1 << no_of_inputs); ++address ) {
-		if( table[address] == ((solution_type == POS) ? ZERO : ONE) )
-			solutions.push_back( SolutionEntry(mask, address ) );
+	/* Everything the solution depends on: the problem itself and the solver that produced it
+	 */
+	key.reserve( 1 + 2 * table.get_word_count() );
+	key.push_back( no_of_inputs | (uint64_t(solution_type) << 8) | (uint64_t(solver_mode) << 16) );
 
-		if( table[address] == DONTCARE )
-			dontcares.push_back( address );
+	for( size_t index = 0; index < table.get_word_count(); ++index ) {
+		key.push_back( table.get_one_word( index ) );
+		key.push_back( table.get_dontcare_word( index ) );
 	}
 
+	return key;
+}
+
+std::vector<uint64_t> KarnaughData::canonical_cache_key( NpnTransform& transform ) const
+{
+	eCellValues target = (solution_type == POS) ? ZERO : ONE;
+	BitVector canonical_target;
+	BitVector canonical_dontcare;
+	BitVector dontcares( table.get_dc_set() );
+	BitVector targets( table.size() );
+	NpnCanonizer canonizer( no_of_inputs );
+	std::vector<uint64_t> key;
+
+	for( size_t index = 0; index < table.get_word_count(); ++index )
+		targets.get_words()[index] = get_word( target, index );
+
+	transform = canonizer.canonize( targets, dontcares, canonical_target, canonical_dontcare );
+
+	/* The solution type is not part of the key, the target set already tells which cells
+	 * are covered. Bit 24 keeps these keys apart from the plain ones.
+	 */
+	key.reserve( 1 + 2 * table.get_word_count() );
+	key.push_back( no_of_inputs | (uint64_t(solver_mode) << 16) | (uint64_t(1) << 24) );
+
+	for( size_t index = 0; index < table.get_word_count(); ++index ) {
+		key.push_back( canonical_target.get_words()[index] );
+		key.push_back( canonical_dontcare.get_words()[index] );
+	}
+
+	return key;
+}
+
+/* Solves with statistics collected for this solve, whether collecting is on or not
+ */
+const SolutionEntries& KarnaughData::find_best_solution( SolverStatistics& statistics )
+{
+	bool was_enabled = statistics_enabled;
+
+	statistics_enabled = true;
+	find_best_solution();
+	statistics_enabled = was_enabled;
+
+	statistics = solver_statistics;
+
+	return the_solution;
+}
+
+/* Solves for as long as the limit allows. Stopped, the best cover found so far is
+ * returned, it is correct but not proven minimal. What a stopped solve found is not
+ * cached, a later solve with more time starts over.
+ */
+const SolutionEntries& KarnaughData::find_best_solution( const SolveLimit& limit )
+{
+	solve_limit = &limit;
+	find_best_solution();
+	solve_limit = nullptr;
+
+	return the_solution;
+}
+
+const SolutionEntries& KarnaughData::find_best_solution( const SolveLimit& limit, SolverStatistics& statistics )
+{
+	solve_limit = &limit;
+	find_best_solution( statistics );
+	solve_limit = nullptr;
+
+	return the_solution;
+}
+
+const SolutionEntries& KarnaughData::find_best_solution( )
+{
+	TraceSpan span( "KarnaughData::find_best_solution" );
+	std::chrono::steady_clock::time_point start;
+
+	if( statistics_enabled ) {
+		solver_statistics.clear();
+		start = std::chrono::steady_clock::now();
+	}
+
+	/* Both keys hold a word of parameters and the two sets of the table. For large tables
+	 * that alone can exceed the cache, then building the key is only a waste of time.
+	 */
+	bool cacheable = solution_cache.admits_key( 1 + 2 * table.get_word_count() );
+	NpnTransform transform( cacheable ? no_of_inputs : 0 );		// only a cached cover is mapped
+	std::vector<uint64_t> key;
+	const SolutionCache::Value * cached = nullptr;
+
+	/* Functions that only differ in the order or polarity of their inputs, or in the
+	 * polarity of the output, share one cache entry stored for their representative.
+	 * Small tables solve in a few times the time it takes to find it (solverbench has
+	 * both), there a miss would cost more than the shared entries save.
+	 */
+	if( cacheable ) {
+		bool canonical = (no_of_inputs >= npn_min_inputs) && (no_of_inputs <= NpnCanonizer::max_inputs);
+
+		key = canonical ? canonical_cache_key( transform ) : cache_key();
+		cached = solution_cache.find( key );
+	}
+
+	solve_stopped = false;
+
+	if( cached ) {
+		the_solution = transform.from_canonical( cached->solution );
+		cover_statistics = cached->cover_statistics;
+		reduction_statistics = cached->reduction_statistics;
+		solution_optimal = cached->optimal;
+
+		/* primes that are kept up to date by set_value are already the right ones
+		 */
+		if( !primes_current )
+			prime_implicants = transform.from_canonical( cached->prime_implicants );
+	} else
+		solve();
+
+	check_solution();
+
+	if( cacheable && !cached && !solve_stopped )
+		solution_cache.insert( key, SolutionCache::Value { transform.to_canonical( the_solution ), transform.to_canonical( prime_implicants ),
+															cover_statistics, reduction_statistics, solution_optimal } );
+
+	if( statistics_enabled ) {
+		solver_statistics.from_cache = (cached != nullptr);
+		solver_statistics.prime_implicants = prime_implicants.size();
+		solver_statistics.total_milliseconds = std::chrono::duration<double, std::milli>( std::chrono::steady_clock::now() - start ).count();
+	}
+
+	return the_solution;
+}
+
+/* Every cover is checked against the table before it is handed out. A wrong one is a bug
+ * in a solver, it is counted and replaced by the cubes of the target cells, which are
+ * correct if not minimal.
+ */
+void KarnaughData::check_solution()
+{
+	PhaseTimer timer( collected_statistics(), SolverStatistics::VERIFICATION );
+	eCellValues target = (solution_type == POS) ? ZERO : ONE;
+
+	if( verifier.verify( the_solution, table, target == ZERO ) )
+		return;
+
+	++verification_failures;
+	the_solution = table_to_cover( target );
+	solution_optimal = false;
+}
+
+void KarnaughData::solve()
+{
+	eCellValues target = (solution_type == POS) ? ZERO : ONE;
+	uint64_t no_of_targets = count_cells( target );
+	uint64_t no_of_dontcares = count_cells( DONTCARE );
+
+	the_solution.clear();
+	cover_statistics = CoverStatistics { false, 0, 0, false };
+	reduction_statistics = ReductionStatistics { 0, 0, 0, 0, 0, 0, 0 };
+	solution_optimal = true;				// the empty and full covers below are, the solvers decide for themselves
+
 	/*	We have four edge cases:
 	 *	If type is SOP we fill the solution with maxterms, thus if the table is all zeroes
 	 *	(or only zeroes and don't cares) the solution is empty. If the table is all ones
@@ -178,56 +410,353 @@ SolutionEntries KarnaughData::find_best_solution( )
 	 *	In the first instance the solution is and remains empty.
 	 *	In the second case the solution has one entry spanning the whole table
 	 */
-	if( solutions.empty() )
-		return the_solution;
+	if( !primes_current )
+		prime_implicants.clear();
+
+	if( no_of_targets == 0 )
+		return;
 
-	if( (solutions.size() + dontcares.size()) == (unsigned int)(1 << no_of_inputs) ) {
+	if( (no_of_targets + no_of_dontcares) == table.size() ) {
 		the_solution.push_back( SolutionEntry(0,0) );
-		return the_solution;
+		return;
 	}
 
-	/* we need to deal with the don't cares
-	 * the only way I currently know is to brute force all possible scenarios
+	if( solver_mode == ISOP ) {
+		solve_isop( target );
+		return;
+	}
+
+	/* Beyond the exact range the tabular methods take too long, use the heuristic minimiser
+	 */
+	if( (solver_mode == HEURISTIC) || (no_of_inputs > exact_input_limit) ) {
+		solve_heuristic( target );
+		return;
+	}
+
+	/* fill list with maxterms ( minterms if POS )
+	 */
+	ThreadPool& solver_pool = get_thread_pool();
+
+	if( workspaces.size() < solver_pool.get_thread_count() )
+		workspaces.resize( solver_pool.get_thread_count() );
+
+	SolverWorkspace& workspace = workspaces.front();
+
+	workspace.reset();
+	collect_addresses( target, workspace.minterms );
+	collect_addresses( DONTCARE, workspace.dontcares );
+
+	/* Every don't care doubles the number of scenarios. Past the limit there are too
+	 * many to go through, the tabular solver gives a cover at least as small anyway.
+	 */
+	if( (solver_mode == ENUMERATE) && (workspace.dontcares.size() <= enumerate_dontcare_limit) )
+		solve_enumerate( workspace.minterms, workspace.dontcares, solver_pool );
+	else
+		solve_tabular( workspace, solver_pool );
+}
+
+void KarnaughData::solve_heuristic( eCellValues target )
+{
+	PhaseTimer timer( collected_statistics(), SolverStatistics::HEURISTIC );
+	Espresso engine( no_of_inputs );
+
+	prime_implicants.clear();
+	primes_current = false;
+
+	engine.set_solve_limit( solve_limit );
+	the_solution = engine.minimise( table_to_cover( target ), table_to_cover( DONTCARE ), table_to_cover( (target == ONE) ? ZERO : ONE ) );
+
+	solution_optimal = false;
+	solve_stopped = engine.is_stopped();
+}
+
+/* An irredundant cover read off a decision diagram of the table, the target cells
+ * being the lower bound and the target and don't care cells the upper bound. Should the
+ * diagram outgrow its node limit the heuristic minimiser takes over.
+ */
+void KarnaughData::solve_isop( eCellValues target )
+{
+	SolutionEntries cover;
+	bool overflowed;
+
+	/* the heuristic fallback times itself
+	 */
+	{
+		PhaseTimer timer( collected_statistics(), SolverStatistics::ISOP );
+		BddManager bdd( no_of_inputs );
+		BitVector targets( table.size() );
+
+		for( size_t index = 0; index < table.get_word_count(); ++index )
+			targets.get_words()[index] = get_word( target, index );
+
+		BddManager::Node lower = bdd.from_cells( targets );
+		BddManager::Node upper = bdd.from_cells( function_set( target ) );
+
+		cover = bdd.isop( lower, upper );
+		overflowed = bdd.is_overflowed();
+	}
+
+	if( overflowed ) {
+		solve_heuristic( target );
+		return;
+	}
+
+	prime_implicants.clear();
+	primes_current = false;
+
+	the_solution = cover;
+	solution_optimal = false;
+}
+
+SolutionEntries KarnaughData::table_to_cover( eCellValues value ) const
+{
+	SolutionEntries cover;
+
+	if( collect_cubes( value, 0, no_of_inputs, cover ) )
+		cover.push_back( SolutionEntry( 0, 0 ) );
+
+	return cover;
+}
+
+bool KarnaughData::collect_cubes( eCellValues value, uint64_t number, unsigned int free_bits, SolutionEntries& cover ) const
+{
+	/* A cube that is entirely value or entirely something else is settled by looking at
+	 * whole words, which takes large uniform areas of the table out of the recursion.
+	 */
+	if( free_bits >= 6 ) {
+		size_t first = number >> 6;
+		size_t last = first + (size_t(1) << (free_bits - 6));
+		bool all_set = true;
+		bool all_clear = true;
+
+		for( size_t index = first; (index < last) && (all_set || all_clear); ++index ) {
+			uint64_t word = get_word( value, index );
+
+			all_set = all_set && (word == ~uint64_t(0));
+			all_clear = all_clear && (word == 0);
+		}
+
+		if( all_set )
+			return true;
+
+		if( all_clear )
+			return false;
+	} else {
+		uint64_t word = get_word( value, number >> 6 ) >> (number & 63);
+		uint64_t cell_mask = (uint64_t(1) << (1u << free_bits)) - 1;
+
+		if( (word & cell_mask) == cell_mask )
+			return true;
+
+		if( (word & cell_mask) == 0 )
+			return false;
+	}
+
+	/* Split the cube on its highest free variable. If both halves hold nothing but value
+	 * the whole cube does, which is left to the caller to merge further. Otherwise a half
+	 * that is complete goes into the cover as is.
+	 */
+	unsigned int bit = 1u << (free_bits - 1);
+	unsigned int variables = (no_of_inputs < 32) ? (1u << no_of_inputs) - 1 : ~0u;
+	unsigned int half_mask = variables & ~(bit - 1);
+
+	bool low = collect_cubes( value, number, free_bits - 1, cover );
+	bool high = collect_cubes( value, number | bit, free_bits - 1, cover );
+
+	if( low && high )
+		return true;
+
+	if( low )
+		cover.push_back( SolutionEntry( half_mask, number ) );
+
+	if( high )
+		cover.push_back( SolutionEntry( half_mask, number | bit ) );
+
+	return false;
+}
+
+void KarnaughData::solve_tabular( SolverWorkspace& workspace, ThreadPool& pool )
+{
+	/* The don't cares take part in the combining stage exactly once, just like the minterms.
+	 * This gives us the prime implicants of the function with every don't care set to one.
+	 * Whether a don't care ends up being covered or not is then decided by the cover
+	 * selection, which only requires the minterms to be covered.
+	 */
+	std::vector<unsigned int>& addresses = workspace.addresses;
+
+	addresses.assign( workspace.minterms.begin(), workspace.minterms.end() );
+	addresses.insert( addresses.end(), workspace.dontcares.begin(), workspace.dontcares.end() );
+
+	/* After a single cell edit set_value has already brought the primes up to date
+	 */
+	if( !primes_current ) {
+		find_prime_implicants( addresses, prime_implicants, collected_statistics() );
+		primes_current = true;
+	}
+
+	/* a pool of one thread has no one to share the branches of the search with
+	 */
+	ThreadPool * search_pool = (pool.get_thread_count() > 1) ? &pool : nullptr;
+
+	select_cover( prime_implicants, workspace.minterms, nullptr, search_pool, workspace, the_solution, cover_statistics, reduction_statistics, collected_statistics() );
+
+	solution_optimal = !cover_statistics.search_truncated;
+	solve_stopped = cover_statistics.search_truncated;
+
+	if( statistics_enabled )
+		solver_statistics.scenarios = 1;
+}
+
+void KarnaughData::solve_enumerate( const std::vector<unsigned int>& minterms, const std::vector<unsigned int>& dontcares, ThreadPool& pool )
+{
+	typedef SolverWorkspace::Candidate Candidate;
+
+	uint64_t no_of_scenarios = uint64_t(1) << dontcares.size();
+	size_t no_of_tasks = std::min<uint64_t>( pool.get_thread_count(), no_of_scenarios );
+	SharedBound bound;
+	std::atomic<bool> stopped( false );
+
+	auto is_better = []( const Candidate& lhs, const Candidate& rhs ) {
+		if( rhs.scenario < 0 )
+			return lhs.scenario >= 0;
+
+		if( lhs.solution.size() != rhs.solution.size() )
+			return lhs.solution.size() < rhs.solution.size();
+
+		return (lhs.literals != rhs.literals) ? lhs.literals < rhs.literals : lhs.scenario < rhs.scenario;
+	};
+
+	/* The first workspace already holds the minterms and don't cares, the others only
+	 * need emptying
+	 */
+	for( size_t task = 1; task < no_of_tasks; ++task )
+		workspaces[task].reset();
+
+	/* Brute force all possible don't care scenarios
 	 * Each don't care can be either 0 or one so with dontcares.size() don't cares
 	 * we have 2 to the power of dontcares.size() possible scenarios.
 	 * Start from the base solutions list and add a subset of don't care addresses
 	 * Solve, rate and repeat with a different subset
+	 *
+	 * The scenarios are dealt out over the threads, each keeping the best one it has
+	 * seen. The cover searches share a bound so a scenario is abandoned once it can only
+	 * do worse than one already solved. Equal covers go to the lowest scenario number,
+	 * which makes the outcome the same for any number of threads.
+	 *
+	 * Every task works in its own workspace. A better scenario trades buffers with the
+	 * best one so far instead of being copied.
+	 *
+	 * Once the solve limit is reached the tasks stop taking new scenarios. Each task
+	 * solves at least its first one, so there always is a cover to return.
+	 *
+	 * A single task runs right here, the pool is only there for more of them.
 	 */
-	for( int scenario = 0; scenario < (1 << dontcares.size()); ++scenario ) {
+	auto run_task = [&]( size_t task ) {
+		SolverWorkspace * workspace = &workspaces[task];
+		Candidate& current = workspace->current;
+		Candidate& best = workspace->best;
+		std::vector<unsigned int>& scenario_list = workspace->addresses;
+		SolverStatistics * statistics = statistics_enabled ? &workspace->statistics : nullptr;
 
-		std::list<SolutionEntry> scenario_list( solutions );
+		for( uint64_t scenario = task; scenario < no_of_scenarios; scenario += no_of_tasks ) {
 
-		/* add the appropriate subset of dont cares
-		 * As it so happens we have a function that transforms a number into a binary vector
-		 * Lets transform the scenario number and add the addresses from the dontcares vector where
-		 * the corresponding binary vector entry is 1
-		 */
-		std::vector<unsigned int> add_address = number_to_binaryvector( scenario, dontcares.size() );
+			if( (scenario != task) && solve_limit && solve_limit->is_reached() ) {
+				stopped = true;
+				break;
+			}
 
-		for( unsigned int index = 0; index < dontcares.size(); ++index )
-			if( add_address[index] )
-				scenario_list.push_back( SolutionEntry(mask, dontcares[index]) );
+			/* add the don't cares whose bit is set in the scenario number, the first
+			 * don't care belongs to the highest bit
+			 */
+			scenario_list.assign( minterms.begin(), minterms.end() );
 
-		find_solution( scenario_list );
+			for( unsigned int index = 0; index < dontcares.size(); ++index )
+				if( (scenario >> (dontcares.size() - 1 - index)) & 1 )
+					scenario_list.push_back( dontcares[index] );
 
-		if( best_solution.empty() || scenario_list.size() < best_solution.size() )
-			best_solution = scenario_list;
-	}
+			current.scenario = int( scenario );		// fits, there are at most 2^enumerate_dontcare_limit
+			find_prime_implicants( scenario_list, current.primes, statistics );
+			select_cover( current.primes, scenario_list, &bound, nullptr, *workspace, current.solution, current.cover, current.reduction, statistics );
 
-	the_solution.reserve( best_solution.size() );
-	std::copy( std::begin(best_solution), std::end(best_solution), std::back_inserter(the_solution) );
+			if( current.cover.search_truncated )
+				stopped = true;
 
-	return the_solution;
+			if( statistics )
+				++statistics->scenarios;
+
+			current.literals = 0;
+			for( const SolutionEntry& entry : current.solution )
+				current.literals += entry.GetLiteralCount();
+
+			if( is_better( current, best ) )
+				std::swap( current, best );
+		}
+	};
+
+	if( no_of_tasks == 1 )
+		run_task( 0 );
+	else
+		for( size_t task = 0; task < no_of_tasks; ++task )
+			pool.submit( [&run_task, task]() { run_task( task ); } );
+
+	pool.wait();
+
+	if( statistics_enabled )
+		for( size_t task = 0; task < no_of_tasks; ++task )
+			solver_statistics.add( workspaces[task].statistics );
+
+	const Candidate * best = &workspaces.front().best;
+
+	for( size_t task = 1; task < no_of_tasks; ++task )
+		if( is_better( workspaces[task].best, *best ) )
+			best = &workspaces[task].best;
+
+	the_solution.assign( best->solution.begin(), best->solution.end() );
+	prime_implicants.assign( best->primes.begin(), best->primes.end() );
+	primes_current = false;
+	cover_statistics = best->cover;
+	reduction_statistics = best->reduction;
+	solution_optimal = !stopped;
+	solve_stopped = stopped;
+}
+
+/* The chart and the memory of the search are those of the workspace, refilled for every
+ * cover
+ */
+void KarnaughData::select_cover( const SolutionEntries& primes, const std::vector<unsigned int>& minterms, SharedBound * bound, ThreadPool * pool, SolverWorkspace& workspace,
+									SolutionEntries& cover, CoverStatistics& cover_stats, ReductionStatistics& reduction_stats, SolverStatistics * statistics ) const
+{
+	PhaseTimer timer( statistics, SolverStatistics::COVER );
+	PrimeChart& chart = workspace.chart;
+
+	chart.assign( primes, minterms );
+
+	CoverSolver solver( chart, bound, pool );
+
+	solver.set_solve_limit( solve_limit );
+	solver.set_buffers( &workspace.search );
+
+	/* Take out everything the chart reductions can decide, only the cyclic core is left to the search
+	 */
+	chart.reduce();
+
+	cover.clear();
+	for( unsigned int row : solver.solve() )
+		cover.push_back( primes[row] );
+
+	reduction_stats = chart.get_statistics();
+	cover_stats = solver.get_statistics();
+
+	if( statistics )
+		statistics->search_nodes += cover_stats.search_nodes;
 }
 
 GridAddresses KarnaughData::get_entry_addresses( const SolutionEntry& entry )
 {
 	GridAddresses addresses;
 
-	for( unsigned int adress : entry.GetAddresses( 1 << no_of_inputs ) ) {
-		GridAddress grid_address = calc_address( adress );
-		addresses.push_back( GridAddress(grid_address.first, grid_address.second) );
-	}
+	for( unsigned int adress : entry.GetAddresses( 1 << no_of_inputs ) )
+		addresses.push_back( calc_address( adress ) );
 
 	return addresses;
 }
@@ -21,10 +21,20 @@
 #define KARNAUGHDATA_H
 
 #include <vector>
-#include <list>
 #include <string>
+#include <memory>
 
 #include "solutionentry.h"
+#include "coversolver.h"
+#include "truthtable.h"
+#include "threadpool.h"
+#include "solutioncache.h"
+#include "npncanonizer.h"
+#include "solverworkspace.h"
+#include "graycodemap.h"
+#include "coververifier.h"
+#include "solverstatistics.h"
+#include "solvelimit.h"
 
 typedef std::pair<unsigned int, unsigned int> GridAddress;
 typedef std::vector<GridAddress> GridAddresses;
@@ -36,15 +46,41 @@ public:
 
 	enum eCellValues { ZERO, ONE, DONTCARE };
 	enum eSolutionType { SOP, POS };
+	enum eSolverMode { TABULAR, ENUMERATE, HEURISTIC, ISOP };
+
+	static const unsigned int max_inputs = TruthTable::max_inputs;
+	static const unsigned int exact_input_limit = 8;		// above this the heuristic minimiser is used
+	static const unsigned int enumerate_dontcare_limit = 16;	// above this ENUMERATE solves like TABULAR
+	static const unsigned int npn_min_inputs = 6;			// smaller tables are cached as they are, not as their NPN class
 
     void set_dimension( unsigned int no_of_inputs );
     void set_value( unsigned int address, eCellValues new_value );
+    void set_table( const TruthTable& new_table );
 	void set_solution_type( eSolutionType type );
+	void set_solver_mode( eSolverMode mode );
+	void set_thread_count( unsigned int count );
+	void set_statistics_enabled( bool enabled ) { statistics_enabled = enabled; }
 
     unsigned int get_dimension( ) const { return no_of_inputs; }
     eSolutionType get_solution_type() const { return solution_type; }
-    eCellValues get_value( unsigned int address ) const { return table[address]; };
-    SolutionEntries find_best_solution( );
+    eSolverMode get_solver_mode() const { return solver_mode; }
+    unsigned int get_thread_count() const { return thread_count; }
+    eCellValues get_value( unsigned int address ) const;
+    bool is_statistics_enabled() const { return statistics_enabled; }
+    const SolutionEntries& find_best_solution( );
+    const SolutionEntries& find_best_solution( SolverStatistics& statistics );
+    const SolutionEntries& find_best_solution( const SolveLimit& limit );
+    const SolutionEntries& find_best_solution( const SolveLimit& limit, SolverStatistics& statistics );
+    bool is_solution_optimal() const { return solution_optimal; }
+    bool is_solve_stopped() const { return solve_stopped; }
+    const SolutionEntries& get_prime_implicants() const { return prime_implicants; }
+    const CoverStatistics& get_cover_statistics() const { return cover_statistics; }
+    const ReductionStatistics& get_reduction_statistics() const { return reduction_statistics; }
+    const SolverStatistics& get_solver_statistics() const { return solver_statistics; }
+    const SolutionCache& get_solution_cache() const { return solution_cache; }
+    void set_cache_capacity( size_t bytes ) { solution_cache.set_capacity( bytes ); }
+    unsigned long get_verification_failures() const { return verification_failures; }
+    SolutionEntries table_to_cover( eCellValues value ) const;		// the cells of value as a list of cubes, not minimised
 
 	GridAddresses get_entry_addresses( unsigned int index );
 	GridAddresses get_entry_addresses( const SolutionEntry& entry );
@@ -56,13 +92,46 @@ public:
 
 private:
 	unsigned int no_of_inputs;
-	std::vector<eCellValues> table;
+	TruthTable table;
+	GrayCodeMap grid_map;
 	eSolutionType solution_type;
+	eSolverMode solver_mode;
+	unsigned int thread_count;				// 0 uses every core
 	SolutionEntries the_solution;
+	SolutionEntries prime_implicants;
+	bool primes_current;					// prime_implicants match the table, kept up to date by set_value
+	CoverStatistics cover_statistics;
+	ReductionStatistics reduction_statistics;
+	SolutionCache solution_cache;
+	std::unique_ptr<ThreadPool> pool;		// kept between solves, recreated when the thread count changes
+	std::vector<SolverWorkspace> workspaces;	// one per solver task, the tabular solver uses the first
+	CoverVerifier verifier;
+	unsigned long verification_failures;	// covers a solver got wrong, replaced before they were handed out
+	bool statistics_enabled;
+	SolverStatistics solver_statistics;		// of the last solve, if collected
+	const SolveLimit * solve_limit;			// of the running solve, none solves until done
+	bool solve_stopped;						// the limit ended the last solve before it was done
+	bool solution_optimal;					// the last solution is proven minimal
 
-	unsigned int gray_encode( unsigned int number );
-	std::vector<unsigned int> number_to_binaryvector( unsigned int code, unsigned int length );
-	void find_solution( std::list<SolutionEntry>& solutions );
+	uint64_t count_cells( eCellValues value ) const;
+	uint64_t get_word( eCellValues value, size_t index ) const;
+	void collect_addresses( eCellValues value, std::vector<unsigned int>& addresses ) const;
+	std::vector<uint64_t> cache_key() const;
+	std::vector<uint64_t> canonical_cache_key( NpnTransform& transform ) const;
+	void solve();
+	void check_solution();
+	SolverStatistics * collected_statistics() { return statistics_enabled ? &solver_statistics : nullptr; }
+	void find_prime_implicants( const std::vector<unsigned int>& addresses, SolutionEntries& primes, SolverStatistics * statistics ) const;
+	void update_prime_implicants( unsigned int address, eCellValues old_value, eCellValues new_value );
+	BitVector function_set( eCellValues target ) const;
+	ThreadPool& get_thread_pool();
+	void solve_tabular( SolverWorkspace& workspace, ThreadPool& pool );
+	void solve_enumerate( const std::vector<unsigned int>& minterms, const std::vector<unsigned int>& dontcares, ThreadPool& pool );
+	void select_cover( const SolutionEntries& primes, const std::vector<unsigned int>& minterms, SharedBound * bound, ThreadPool * pool, SolverWorkspace& workspace,
+						SolutionEntries& cover, CoverStatistics& cover_stats, ReductionStatistics& reduction_stats, SolverStatistics * statistics ) const;
+	void solve_heuristic( eCellValues target );
+	void solve_isop( eCellValues target );
+	bool collect_cubes( eCellValues value, uint64_t number, unsigned int free_bits, SolutionEntries& cover ) const;
 };
 
 static GridAddress InvalidGridAddress(-1, -1);
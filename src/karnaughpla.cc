@@ -0,0 +1,360 @@
+/*
+ * Copyright 2024 Alwin Leerling <dna.leerling@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+/* Command line minimiser for Berkeley PLA files
+ *
+ *	karnaughpla [-m tabular|enumerate|heuristic|isop] [-j threads] [-b milliseconds] [-o directory] [-t trace] [file ...]
+ *
+ * Every file is minimised and written as a PLA of type f, into the directory given with
+ * -o under the same name, otherwise to standard output. Without files standard input is
+ * read. The time taken per file goes to standard error.
+ *
+ * The enumerate mode tries every assignment of the don't cares. A file can have any
+ * number of them, so functions with more than KarnaughData::enumerate_dontcare_limit
+ * are minimised like in the tabular mode.
+ *
+ * The files run through a pipeline: one thread reads and parses them, -j threads (all
+ * cores by default) minimise them and the main thread writes the results in the order
+ * of the files. The stages pass files through bounded queues and the reader stays at
+ * most a fixed number of files ahead of the writer, so memory use does not depend on
+ * the number of files.
+ *
+ * With -b every file gets at most the given time to be minimised, past it the best cover
+ * found so far is written and the file is reported as stopped. So is a file of several
+ * outputs whose cover search ran into MultiOutputData::search_node_limit.
+ *
+ * With -t the stages and solver phases of every thread are traced, the trace is written
+ * to the given file at the end for chrome://tracing or Perfetto.
+ *
+ * Every solving thread keeps its own solvers from one file to the next. Single output
+ * functions go through KarnaughData in the chosen mode, so repeated functions come from
+ * its cache. Multiple outputs are minimised together with shared products.
+ */
+
+#include <iostream>
+#include <fstream>
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <cstdlib>
+
+#include "plafile.h"
+#include "karnaughdata.h"
+#include "multioutputdata.h"
+#include "threadpool.h"
+#include "boundedqueue.h"
+#include "tracer.h"
+
+static void usage()
+{
+	std::cerr << "usage: karnaughpla [-m tabular|enumerate|heuristic|isop] [-j threads] [-b milliseconds] [-o directory] [-t trace] [file ...]\n";
+}
+
+static bool parse_mode( const std::string& name, KarnaughData::eSolverMode& mode )
+{
+	const char * names[] = { "tabular", "enumerate", "heuristic", "isop" };
+	const KarnaughData::eSolverMode modes[] = { KarnaughData::TABULAR, KarnaughData::ENUMERATE, KarnaughData::HEURISTIC, KarnaughData::ISOP };
+
+	for( unsigned int index = 0; index < 4; ++index )
+		if( name == names[index] ) {
+			mode = modes[index];
+			return true;
+		}
+
+	return false;
+}
+
+static std::string output_path( const std::string& directory, const std::string& file )
+{
+	std::string::size_type slash = file.find_last_of( '/' );
+
+	return directory + "/" + ((slash == std::string::npos) ? file : file.substr( slash + 1 ));
+}
+
+/* Returns false if the products do not implement the file. KarnaughData replaces a wrong
+ * cover itself, the shared products are checked here.
+ */
+static bool minimise( const PlaFile& pla, const SolveLimit& limit, KarnaughData& single, MultiOutputData& multiple, SharedProducts& products, bool& stopped )
+{
+	TraceSpan span( "minimise" );
+
+	products.clear();
+
+	if( pla.get_outputs() == 1 ) {
+		single.set_table( pla.get_table( 0 ) );
+
+		for( const SolutionEntry& entry : single.find_best_solution( limit ) )
+			products.push_back( SharedProduct { entry, 1 } );
+
+		stopped = single.is_solve_stopped();
+
+		return true;
+	}
+
+	multiple.set_dimension( pla.get_inputs(), pla.get_outputs() );
+
+	for( unsigned int output = 0; output < pla.get_outputs(); ++output )
+		multiple.set_table( output, pla.get_table( output ) );
+
+	products = multiple.find_best_solution( limit );
+	stopped = multiple.is_solve_stopped();
+
+	return multiple.verify_solution();
+}
+
+/* One file on its way through the pipeline
+ */
+struct Job
+{
+	size_t index;
+	std::string file;
+	PlaFile pla;
+	SharedProducts products;
+	std::string failure;				// empty as long as all goes well
+	bool stopped;						// the time or search limit ended the solve, the products may not be minimal
+	double milliseconds;				// reading and minimising
+};
+
+typedef std::unique_ptr<Job> JobPointer;
+
+class Pipeline
+{
+public:
+	Pipeline( const std::vector<std::string>& files, const std::string& directory, KarnaughData::eSolverMode mode, unsigned int no_of_solvers,
+				std::chrono::milliseconds budget );
+
+	bool run();
+
+private:
+	const std::vector<std::string>& files;
+	std::string directory;
+	KarnaughData::eSolverMode mode;
+	unsigned int no_of_solvers;
+	std::chrono::milliseconds budget;		// per file, 0 minimises without limit
+	size_t window;						// files read but not yet written, at most
+
+	BoundedQueue<JobPointer> read_jobs;
+	BoundedQueue<JobPointer> solved_jobs;
+	std::atomic<unsigned int> running_solvers;
+
+	std::mutex mutex;
+	std::condition_variable job_written;
+	size_t next_to_write;
+
+	void read_files();
+	void solve_jobs();
+	bool write_job( const Job& job );
+};
+
+Pipeline::Pipeline( const std::vector<std::string>& files, const std::string& directory, KarnaughData::eSolverMode mode, unsigned int no_of_solvers,
+					std::chrono::milliseconds budget )
+	: files( files ), directory( directory ), mode( mode ), no_of_solvers( no_of_solvers ), budget( budget ), window( 4 * no_of_solvers + 4 ),
+	  read_jobs( 2 * no_of_solvers ), solved_jobs( 2 * no_of_solvers ), running_solvers( no_of_solvers ), next_to_write( 0 )
+{
+}
+
+bool Pipeline::run()
+{
+	std::map<size_t, JobPointer> waiting;
+	JobPointer job;
+	bool all_done = true;
+
+	std::thread reader( &Pipeline::read_files, this );
+	std::vector<std::thread> solvers;
+
+	for( unsigned int index = 0; index < no_of_solvers; ++index )
+		solvers.emplace_back( &Pipeline::solve_jobs, this );
+
+	/* Jobs finish in any order, the ones ahead of the next file wait here. The window
+	 * keeps their number bounded.
+	 */
+	while( solved_jobs.pop( job ) ) {
+		waiting[job->index] = std::move( job );
+
+		while( !waiting.empty() && (waiting.begin()->first == next_to_write) ) {
+			all_done = write_job( *waiting.begin()->second ) && all_done;
+			waiting.erase( waiting.begin() );
+
+			std::lock_guard<std::mutex> lock( mutex );
+			++next_to_write;
+			job_written.notify_one();
+		}
+	}
+
+	reader.join();
+	for( std::thread& solver : solvers )
+		solver.join();
+
+	return all_done;
+}
+
+void Pipeline::read_files()
+{
+	for( size_t index = 0; index < files.size(); ++index ) {
+		{
+			std::unique_lock<std::mutex> lock( mutex );
+			job_written.wait( lock, [this, index]() { return index < next_to_write + window; } );
+		}
+
+		auto start = std::chrono::steady_clock::now();
+		JobPointer job( new Job );
+		std::ifstream input_file;
+
+		job->index = index;
+		job->file = files[index];
+		job->stopped = false;
+
+		if( job->file != "-" )
+			input_file.open( job->file );
+
+		if( (job->file != "-") && !input_file )
+			job->failure = "cannot open";
+		else if( !job->pla.read( (job->file == "-") ? std::cin : input_file ) )
+			job->failure = job->pla.get_error();
+
+		job->milliseconds = std::chrono::duration<double, std::milli>( std::chrono::steady_clock::now() - start ).count();
+
+		read_jobs.push( std::move( job ) );
+	}
+
+	read_jobs.close();
+}
+
+void Pipeline::solve_jobs()
+{
+	KarnaughData single;
+	MultiOutputData multiple;
+	JobPointer job;
+
+	/* the files are the parallel part, each solve stays on its own thread
+	 */
+	single.set_thread_count( 1 );
+	single.set_solver_mode( mode );
+
+	while( read_jobs.pop( job ) ) {
+		auto start = std::chrono::steady_clock::now();
+		SolveLimit limit;
+
+		if( budget.count() )
+			limit.set_deadline( start + budget );
+
+		if( job->failure.empty() && !minimise( job->pla, limit, single, multiple, job->products, job->stopped ) )
+			job->failure = "the minimised products do not implement the function";
+
+		job->milliseconds += std::chrono::duration<double, std::milli>( std::chrono::steady_clock::now() - start ).count();
+
+		solved_jobs.push( std::move( job ) );
+	}
+
+	if( --running_solvers == 0 )
+		solved_jobs.close();
+}
+
+bool Pipeline::write_job( const Job& job )
+{
+	if( !job.failure.empty() ) {
+		std::cerr << job.file << ": " << job.failure << "\n";
+		return false;
+	}
+
+	if( directory.empty() || (job.file == "-") )
+		job.pla.write( std::cout, job.products );
+	else {
+		std::ofstream output_file( output_path( directory, job.file ) );
+
+		job.pla.write( output_file, job.products );
+
+		if( !output_file ) {
+			std::cerr << output_path( directory, job.file ) << ": cannot write\n";
+			return false;
+		}
+	}
+
+	std::cerr << job.file << ": " << job.pla.get_inputs() << " inputs, " << job.pla.get_outputs() << " outputs, "
+			  << job.pla.get_product_count() << " -> " << job.products.size() << " products, " << job.milliseconds << " ms"
+			  << (job.stopped ? ", stopped at the time or search limit" : "") << "\n";
+
+	return true;
+}
+
+int main( int argc, char * argv[] )
+{
+	KarnaughData::eSolverMode mode = KarnaughData::TABULAR;
+	unsigned int no_of_solvers = ThreadPool::default_thread_count();
+	unsigned long budget = 0;
+	std::string directory;
+	std::string trace_file;
+	std::vector<std::string> files;
+
+	for( int index = 1; index < argc; ++index ) {
+		std::string argument = argv[index];
+
+		if( (argument == "-m") && (index + 1 < argc) ) {
+			if( !parse_mode( argv[++index], mode ) ) {
+				usage();
+				return 2;
+			}
+		} else if( (argument == "-j") && (index + 1 < argc) ) {
+			no_of_solvers = std::strtoul( argv[++index], nullptr, 10 );
+
+			if( no_of_solvers == 0 ) {
+				usage();
+				return 2;
+			}
+		} else if( (argument == "-b") && (index + 1 < argc) )
+			budget = std::strtoul( argv[++index], nullptr, 10 );
+		else if( (argument == "-o") && (index + 1 < argc) )
+			directory = argv[++index];
+		else if( (argument == "-t") && (index + 1 < argc) )
+			trace_file = argv[++index];
+		else if( (argument.size() > 1) && (argument[0] == '-') ) {
+			usage();
+			return 2;
+		} else
+			files.push_back( argument );
+	}
+
+	if( files.empty() )
+		files.push_back( "-" );
+
+	Tracer::set_enabled( !trace_file.empty() );
+
+	auto start = std::chrono::steady_clock::now();
+	Pipeline pipeline( files, directory, mode, no_of_solvers, std::chrono::milliseconds( budget ) );
+	bool all_done = pipeline.run();
+
+	std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+	if( files.size() > 1 )
+		std::cerr << files.size() << " files in " << elapsed.count() << " ms\n";
+
+	if( !trace_file.empty() && !Tracer::write( trace_file ) ) {
+		std::cerr << trace_file << ": cannot write\n";
+		return 1;
+	}
+
+	return all_done ? 0 : 1;
+}
@@ -26,6 +26,7 @@
 #include "truthtablegrid.h"
 #include "kmapgrid.h"
 #include "solutiontree.h"
+#include "tracer.h"
 
 BEGIN_EVENT_TABLE( KarnaughWindow, wxFrame )
     EVT_MENU( QUIT_MENU, KarnaughWindow::OnQuit )
@@ -33,6 +34,8 @@ BEGIN_EVENT_TABLE( KarnaughWindow, wxFrame )
     EVT_MENU( SET_LANGUAGE_MENU, KarnaughWindow::OnSetLanguage )
     EVT_MENU( SHOW_CELL_ADDRESS_MENU, KarnaughWindow::OnShowCellAddress )
     EVT_MENU( SHOW_ZERO_MENU, KarnaughWindow::OnShowZero )
+    EVT_MENU( RECORD_TRACE_MENU, KarnaughWindow::OnRecordTrace )
+    EVT_MENU( SAVE_TRACE_MENU, KarnaughWindow::OnSaveTrace )
     EVT_SPINCTRL( INPUT_VAR_SPINNER, KarnaughWindow::OnInputVarChange )
     EVT_GRID_CMD_CELL_CHANGE( TRUTHTABLE_GRID, KarnaughWindow::OnTruthTableChange )
     EVT_GRID_CMD_CELL_CHANGE( KMAP_GRID, KarnaughWindow::OnKMapChange )
@@ -60,6 +63,9 @@ KarnaughWindow::KarnaughWindow( KarnaughApp& app_init )
     mnuSettings->Append( new wxMenuItem( 0, SET_LANGUAGE_MENU, _( "Set language" ), _( "Set language" ) ) );
     mnuSettings->Append( new wxMenuItem( 0, SHOW_ZERO_MENU, _( "Show zeros" ), _( "Show / hide zero values" ), wxITEM_CHECK ) );
     mnuSettings->Append( new wxMenuItem( 0, SHOW_CELL_ADDRESS_MENU, _( "Show cell addresses" ), _( "Show / hide cell addresses in the K-map" ), wxITEM_CHECK ) );
+    mnuSettings->AppendSeparator();
+    mnuSettings->Append( new wxMenuItem( 0, RECORD_TRACE_MENU, _( "Record trace" ), _( "Record where the time of solving and updating goes" ), wxITEM_CHECK ) );
+    mnuSettings->Append( new wxMenuItem( 0, SAVE_TRACE_MENU, _( "Save trace..." ), _( "Save the recorded trace for chrome://tracing" ) ) );
     menuBar->Append( mnuSettings, _( "&Settings" ) );
 
     SetMenuBar( menuBar );
@@ -140,19 +146,42 @@ void KarnaughWindow::PreSolver( )
 
 void KarnaughWindow::PostSolverStart( bool isSOP, unsigned int solution_size )
 {
+	TraceSpan span( "KarnaughWindow::PostSolverStart" );
+
     treeSolution->RemoveAllItems( isSOP, solution_size );
     gridKMap->ResetBackgroundColour( isSOP, solution_size );
 }
 
 void KarnaughWindow::PostSolverAdd( SolutionEntry& entry, bool isSOP, GridAddresses addresses, unsigned int id )
 {
+	TraceSpan span( "KarnaughWindow::PostSolverAdd" );
+
 	gridKMap->SetBackgroundColour( isSOP, addresses );
 	treeSolution->AddItem( isSOP, entry.GetMask(), entry.GetNumber(), id );
 }
 
-void KarnaughWindow::PostSolverFinish()
+void KarnaughWindow::PostSolverFinish( const SolverStatistics& statistics, bool stopped )
 {
-    SetStatusText( _( "Karnaugh map solved!" ) );
+	if( stopped ) {
+		SetStatusText( wxString::Format( _( "Stopped after %.2f ms, the solution may not be minimal" ), statistics.total_milliseconds ) );
+		return;
+	}
+
+	if( statistics.from_cache ) {
+		SetStatusText( wxString::Format( _( "Solved in %.2f ms from the cache" ), statistics.total_milliseconds ) );
+		return;
+	}
+
+	const wxString phase_names[SolverStatistics::no_of_phases] = { _( "tabulation" ), _( "cover" ), _( "heuristic" ), _( "ISOP" ), _( "check" ) };
+	wxString phases;
+
+	for( unsigned int phase = 0; phase < SolverStatistics::no_of_phases; ++phase )
+		if( statistics.phase_milliseconds[phase] > 0 )
+			phases += wxString::Format( ", %s %.2f ms", phase_names[phase], statistics.phase_milliseconds[phase] );
+
+	SetStatusText( wxString::Format( _( "Solved in %.2f ms%s - %lu primes, %lu merges, %lu search nodes, %lu scenarios" ),
+										statistics.total_milliseconds, phases, statistics.prime_implicants, statistics.merges,
+										statistics.search_nodes, statistics.scenarios ) );
 }
 
 void KarnaughWindow::SetNewValue( unsigned int adress, GridAddress grid_adress, KarnaughData::eCellValues new_value )
@@ -193,6 +222,11 @@ void KarnaughWindow::SetNewShowZeroes( bool on )
 	gridTruthTable->SetShowZeros( on );
 }
 
+void KarnaughWindow::SetNewTracing( bool on )
+{
+    mnuSettings->Check( RECORD_TRACE_MENU, on );
+}
+
 void KarnaughWindow::SetSolutionSelection( GridAddresses addresses )
 {
 	gridKMap->ResetSelection();
@@ -210,6 +244,13 @@ long KarnaughWindow::GetLanguageChoice( wxArrayString languages )
     return dialog.ShowModal() == wxID_OK ? dialog.GetSelection() : -1;
 }
 
+wxString KarnaughWindow::GetTraceFileName()
+{
+	wxFileDialog dialog( this, _( "Save trace" ), wxEmptyString, "karnaugh-trace.json", _( "Trace files (*.json)|*.json" ), wxFD_SAVE | wxFD_OVERWRITE_PROMPT );
+
+	return dialog.ShowModal() == wxID_OK ? dialog.GetPath() : wxString();
+}
+
 void KarnaughWindow::OnInputVarChange( wxSpinEvent& event )
 {
 	app.SetInputs( event.GetPosition() );
@@ -255,6 +296,16 @@ void KarnaughWindow::OnShowZero( wxCommandEvent& event )
 	app.SetNewShowZeroes( event.IsChecked() );
 }
 
+void KarnaughWindow::OnRecordTrace( wxCommandEvent& event )
+{
+	app.SetTracing( event.IsChecked() );
+}
+
+void KarnaughWindow::OnSaveTrace( wxCommandEvent& WXUNUSED( event ) )
+{
+	app.SaveTrace();
+}
+
 void KarnaughWindow::OnAbout( wxCommandEvent& WXUNUSED( event ) )
 {
     wxMessageBox( _( "This is a program for minimizing boolean functions using Karnaugh maps method."
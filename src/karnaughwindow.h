@@ -44,16 +44,18 @@ public:
 	void SetSolutionSelection( GridAddresses addresses );
 	void SetNewShowAddress( bool on );
 	void SetNewShowZeroes( bool on );
+	void SetNewTracing( bool on );
 
 	void PreSolver( );
 	void PostSolverStart( bool isSOP, unsigned int solution_size );
 	void PostSolverAdd( SolutionEntry& entry, bool isSOP, GridAddresses addresses, unsigned int id );
-	void PostSolverFinish();
+	void PostSolverFinish( const SolverStatistics& statistics, bool stopped );
 
 	long GetLanguageChoice( wxArrayString languages );
+	wxString GetTraceFileName();
 
 private:
-    enum { QUIT_MENU = 100, ABOUT_MENU, SET_LANGUAGE_MENU, SHOW_CELL_ADDRESS_MENU, SHOW_ZERO_MENU,
+    enum { QUIT_MENU = 100, ABOUT_MENU, SET_LANGUAGE_MENU, SHOW_CELL_ADDRESS_MENU, SHOW_ZERO_MENU, RECORD_TRACE_MENU, SAVE_TRACE_MENU,
 							INPUT_VAR_SPINNER, TRUTHTABLE_GRID, KMAP_GRID, SOLUTION_TREE, SOLUTIONTYPE_COMBO };
 
     void OnQuit( wxCommandEvent& event );
@@ -61,6 +63,8 @@ private:
 	void OnSetLanguage( wxCommandEvent& event );
     void OnShowCellAddress( wxCommandEvent& event );
     void OnShowZero( wxCommandEvent& event );
+    void OnRecordTrace( wxCommandEvent& event );
+    void OnSaveTrace( wxCommandEvent& event );
     void OnInputVarChange( wxSpinEvent& event );
     void OnTruthTableChange( wxGridEvent& event );
     void OnKMapChange( wxGridEvent& event );
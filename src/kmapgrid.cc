@@ -21,6 +21,8 @@
 
 #include <wx/font.h>
 
+#include "tracer.h"
+
 BEGIN_EVENT_TABLE( KMapGrid, wxGrid )
     EVT_GRID_CELL_RIGHT_CLICK( KMapGrid::DisplayPopup )
     EVT_MENU_RANGE( MENU_SET1, MENU_SETRAND, KMapGrid::OnMenuRange )
@@ -30,7 +32,7 @@ END_EVENT_TABLE()
 class KMapGridCellRenderer : public wxGridCellStringRenderer
 {
 public:
-	KMapGridCellRenderer( ) : font( wxFontInfo(7).Family( wxFONTFAMILY_MODERN ) ), do_show_greycode( true ), do_draw_zeros( true ) {};
+	KMapGridCellRenderer( const GrayCodeMap& map ) : font( wxFontInfo(7).Family( wxFONTFAMILY_MODERN ) ), map( map ), do_show_greycode( true ), do_draw_zeros( true ) {};
 
 	void show_greycode( bool on ) { do_show_greycode = on; };
 	void draw_zeros( bool on ) { do_draw_zeros = on; };
@@ -40,6 +42,7 @@ protected:
 
 private:
 	wxFont font;
+	const GrayCodeMap& map;
 	bool do_show_greycode;
 	bool do_draw_zeros;
 };
@@ -66,13 +69,7 @@ void KMapGridCellRenderer::Draw( wxGrid& grid, wxGridCellAttr& attr, wxDC& dc, c
 
 		int w, h;
 
-		unsigned i;
-		for( i = 0; (1 << i) < grid.GetNumberCols(); ++i )
-			;
-
-		auto GreyEncode = []( unsigned int number ) { return number ^ (number >> 1); };
-
-		unsigned int grey_code = ( GreyEncode(row) << i ) + GreyEncode(col);
+		unsigned int grey_code = map.get_address( row, col );
 
 		dc.GetTextExtent( wxString::Format( "%d", grey_code ), &w, &h );
 		dc.DrawText( wxString::Format( "%d", grey_code ), rect.GetX()+rect.GetWidth()-w-2, rect.GetY()+rect.GetHeight()-h-1 );
@@ -87,7 +84,7 @@ KMapGrid::KMapGrid( wxWindow* parent, wxWindowID id, const wxSize& size )
     SetDefaultCellAlignment( wxALIGN_CENTRE, wxALIGN_CENTRE );
     EnableDragGridSize( 0 );
 
-	renderer = new KMapGridCellRenderer();
+	renderer = new KMapGridCellRenderer( gray_code_map );
     SetDefaultRenderer( renderer );
 
     mnuPopup = new wxMenu;
@@ -112,6 +109,7 @@ void KMapGrid::SetValue( unsigned int row, unsigned int col, KarnaughData::eCell
 
 void KMapGrid::ResetBackgroundColour( bool isSOP, unsigned int solution_size )
 {
+	TraceSpan span( "KMapGrid::ResetBackgroundColour" );
 	wxColour the_colour = GetDefaultCellBackgroundColour();
 	if( !isSOP )
 		the_colour = wxColour( the_colour.Red()-(solution_size * 40), the_colour.Green()-(solution_size * 30), the_colour.Blue() );
@@ -125,6 +123,8 @@ void KMapGrid::ResetBackgroundColour( bool isSOP, unsigned int solution_size )
 
 void KMapGrid::SetBackgroundColour( bool isSOP, GridAddresses addresses )
 {
+	TraceSpan span( "KMapGrid::SetBackgroundColour" );
+
 	for( GridAddress address : addresses ) {
 		wxColour current = GetCellBackgroundColour( address.first, address.second );
 		if( isSOP )
@@ -151,8 +151,10 @@ void KMapGrid::SetVars( unsigned int vars )
 {
     ClearGrid();
 
-    int height = 1 << (vars / 2);
-    int width = 1 << ((vars + 1) / 2);
+    gray_code_map.set_dimension( vars );
+
+    int height = gray_code_map.get_row_count();
+    int width = gray_code_map.get_col_count();
 
     if( GetNumberCols() < width  ) AppendCols( width - GetNumberCols() );
     if( GetNumberRows() < height ) AppendRows( height - GetNumberRows() );
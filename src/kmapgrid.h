@@ -24,6 +24,7 @@
 #include <wx/grid.h>
 
 #include "karnaughdata.h"
+#include "graycodemap.h"
 
 class KMapGridCellRenderer;
 
@@ -54,6 +55,7 @@ private:
 
     wxMenu* mnuPopup;
     KMapGridCellRenderer * renderer;
+    GrayCodeMap gray_code_map;			// cell addresses for the renderer
 
     DECLARE_EVENT_TABLE()
 };
@@ -0,0 +1,413 @@
+/*
+ * Copyright 2024 Alwin Leerling <dna.leerling@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#include "multioutputdata.h"
+
+#include <algorithm>
+#include <bitset>
+#include <map>
+
+#include "primechart.h"
+#include "espresso.h"
+
+const unsigned int MultiOutputData::max_outputs;
+const unsigned long MultiOutputData::search_node_limit;
+
+MultiOutputData::MultiOutputData()
+{
+	no_of_inputs = 0;
+	outputs.resize( 1 );
+	solution_type = KarnaughData::SOP;
+	cover_statistics = CoverStatistics { false, 0, 0, false };
+	reduction_statistics = ReductionStatistics { 0, 0, 0, 0, 0, 0, 0 };
+	solve_limit = nullptr;
+}
+
+void MultiOutputData::set_dimension( unsigned int no_of_inputs, unsigned int no_of_outputs )
+{
+	if( no_of_inputs > KarnaughData::max_inputs )
+		no_of_inputs = KarnaughData::max_inputs;
+
+	no_of_outputs = std::max( 1U, std::min( no_of_outputs, max_outputs ) );
+
+	this->no_of_inputs = no_of_inputs;
+
+	outputs.assign( no_of_outputs, TruthTable() );
+	for( TruthTable& table : outputs )
+		table.resize( no_of_inputs );
+
+	the_solution.clear();
+}
+
+void MultiOutputData::set_value( unsigned int output, unsigned int address, KarnaughData::eCellValues new_value )
+{
+	if( (output >= outputs.size()) || (address >= outputs[output].size()) )
+		return;
+
+	switch( new_value ) {
+	case KarnaughData::ONE: outputs[output].set_one( address ); break;
+	case KarnaughData::DONTCARE: outputs[output].set_dontcare( address ); break;
+	default: outputs[output].set_zero( address ); break;
+	}
+}
+
+/* The table has to be of the current number of inputs
+ */
+void MultiOutputData::set_table( unsigned int output, const TruthTable& table )
+{
+	if( (output >= outputs.size()) || (table.get_no_of_inputs() != no_of_inputs) )
+		return;
+
+	outputs[output] = table;
+}
+
+KarnaughData::eCellValues MultiOutputData::get_value( unsigned int output, unsigned int address ) const
+{
+	if( outputs[output].is_dontcare( address ) )
+		return KarnaughData::DONTCARE;
+
+	return outputs[output].is_one( address ) ? KarnaughData::ONE : KarnaughData::ZERO;
+}
+
+void MultiOutputData::set_solution_type( KarnaughData::eSolutionType type )
+{
+	solution_type = type;
+}
+
+bool MultiOutputData::is_target( unsigned int output, unsigned int address ) const
+{
+	return (solution_type == KarnaughData::POS) ? outputs[output].is_zero( address ) : outputs[output].is_one( address );
+}
+
+bool MultiOutputData::is_allowed( unsigned int output, unsigned int address ) const
+{
+	return is_target( output, address ) || outputs[output].is_dontcare( address );
+}
+
+const SharedProducts& MultiOutputData::find_best_solution()
+{
+	the_solution.clear();
+	cover_statistics = CoverStatistics { false, 0, 0, false };
+	reduction_statistics = ReductionStatistics { 0, 0, 0, 0, 0, 0, 0 };
+
+	if( no_of_inputs > KarnaughData::exact_input_limit )
+		solve_heuristic();
+	else
+		solve_exact();
+
+	return the_solution;
+}
+
+const SharedProducts& MultiOutputData::find_best_solution( const SolveLimit& limit )
+{
+	solve_limit = &limit;
+	find_best_solution();
+	solve_limit = nullptr;
+
+	return the_solution;
+}
+
+SharedProducts MultiOutputData::find_shared_implicants() const
+{
+	struct Implicant {
+		SolutionEntry cube;
+		unsigned int outputs;
+		bool prime;
+	};
+
+	auto ones = []( unsigned int number ) { return std::bitset<32>( number ).count(); };
+	auto level_order = [&ones]( const Implicant& lhs, const Implicant& rhs ) {
+		if( lhs.cube.GetMask() != rhs.cube.GetMask() )
+			return lhs.cube.GetMask() < rhs.cube.GetMask();
+
+		if( ones( lhs.cube.GetNumber() ) != ones( rhs.cube.GetNumber() ) )
+			return ones( lhs.cube.GetNumber() ) < ones( rhs.cube.GetNumber() );
+
+		return lhs.cube.GetNumber() < rhs.cube.GetNumber();
+	};
+
+	unsigned int mask = (1 << no_of_inputs) - 1;
+	std::vector<Implicant> level;
+	std::vector<Implicant> next_level;
+	SharedProducts primes;
+
+	/* Every cell starts out tagged with the outputs it is allowed in
+	 */
+	for( unsigned int address = 0; address <= mask; ++address ) {
+		unsigned int tag = 0;
+
+		for( unsigned int output = 0; output < outputs.size(); ++output )
+			if( is_allowed( output, address ) )
+				tag |= 1 << output;
+
+		if( tag )
+			level.push_back( Implicant { SolutionEntry( mask, address ), tag, true } );
+	}
+
+	/* The tabulation of the single output case, with one change: two cubes combine when
+	 * their tags share an output and the result carries the shared outputs only. A cube
+	 * stops being prime once it has combined into a cube serving all of its outputs.
+	 */
+	while( !level.empty() ) {
+
+		std::sort( level.begin(), level.end(), level_order );
+		next_level.clear();
+
+		for( auto lower_begin = level.begin(); lower_begin != level.end(); ) {
+
+			auto lower_end = std::find_if( lower_begin, level.end(), [&]( const Implicant& entry )
+								{ return !entry.cube.MaskEqual( lower_begin->cube ) || (ones( entry.cube.GetNumber() ) != ones( lower_begin->cube.GetNumber() )); } );
+			auto upper_end = std::find_if( lower_end, level.end(), [&]( const Implicant& entry )
+								{ return !entry.cube.MaskEqual( lower_begin->cube ) || (ones( entry.cube.GetNumber() ) != ones( lower_begin->cube.GetNumber() ) + 1); } );
+
+			for( auto lower = lower_begin; lower != lower_end; ++lower ) {
+				for( auto upper = lower_end; upper != upper_end; ++upper ) {
+
+					unsigned int xor_number = lower->cube.ComputeXOR( upper->cube );
+					unsigned int tag = lower->outputs & upper->outputs;
+
+					if( ((xor_number & (xor_number - 1)) != 0) || !tag )
+						continue;
+
+					next_level.push_back( Implicant { lower->cube.ComputeNewEntry( xor_number ), tag, true } );
+
+					if( tag == lower->outputs )
+						lower->prime = false;
+
+					if( tag == upper->outputs )
+						upper->prime = false;
+				}
+			}
+
+			lower_begin = lower_end;
+		}
+
+		for( const Implicant& entry : level )
+			if( entry.prime )
+				primes.push_back( SharedProduct { entry.cube, entry.outputs } );
+
+		/* a cube made in several ways always gets the same tag, the outputs all its cells share
+		 */
+		std::sort( next_level.begin(), next_level.end(), level_order );
+		next_level.erase( std::unique( next_level.begin(), next_level.end(), []( const Implicant& lhs, const Implicant& rhs )
+								{ return lhs.cube == rhs.cube; } ), next_level.end() );
+
+		level.swap( next_level );
+	}
+
+	return primes;
+}
+
+void MultiOutputData::solve_exact()
+{
+	SharedProducts primes = find_shared_implicants();
+	std::vector<std::pair<unsigned int, unsigned int>> columns;	// output, address
+	std::vector<BitVector> rows;
+	std::vector<unsigned int> row_costs;
+
+	for( unsigned int output = 0; output < outputs.size(); ++output )
+		for( unsigned int address = 0; address < outputs[output].size(); ++address )
+			if( is_target( output, address ) )
+				columns.push_back( std::make_pair( output, address ) );
+
+	/* A product covers a target cell of every output in its tag
+	 */
+	for( const SharedProduct& prime : primes ) {
+		BitVector row( columns.size() );
+
+		for( unsigned int column = 0; column < columns.size(); ++column )
+			if( ((prime.outputs >> columns[column].first) & 1) && ((columns[column].second & prime.product.GetMask()) == prime.product.GetNumber()) )
+				row.set( column );
+
+		rows.push_back( row );
+		row_costs.push_back( prime.product.GetLiteralCount() );
+	}
+
+	PrimeChart chart( rows, row_costs, columns.size() );
+	CoverSolver solver( chart );
+
+	chart.reduce();
+	solver.set_node_limit( search_node_limit );
+	solver.set_solve_limit( solve_limit );
+
+	/* A selected product only feeds the outputs it actually covers a target of
+	 */
+	for( unsigned int row : solver.solve() ) {
+		unsigned int used = 0;
+
+		for( size_t column = rows[row].find_first(); column != BitVector::npos; column = rows[row].find_next( column + 1 ) )
+			used |= 1 << columns[column].first;
+
+		the_solution.push_back( SharedProduct { primes[row].product, used } );
+	}
+
+	reduction_statistics = chart.get_statistics();
+	cover_statistics = solver.get_statistics();
+}
+
+/* Output o becomes the variable y_o following the inputs, and a cell of output o the
+ * point of its inputs with y_o set and every other y clear. The points with no y or
+ * several set are don't cares. A cube with the y of a set of outputs free and the others
+ * clear then covers its cells in exactly those outputs: it is a product feeding them.
+ * The minimiser raises the y of a cube like any other literal, that is how a product
+ * takes on more outputs. A cube with one y set only serves that output.
+ */
+void MultiOutputData::solve_heuristic()
+{
+	KarnaughData::eCellValues target = (solution_type == KarnaughData::POS) ? KarnaughData::ZERO : KarnaughData::ONE;
+	KarnaughData::eCellValues other = (solution_type == KarnaughData::POS) ? KarnaughData::ONE : KarnaughData::ZERO;
+	unsigned int no_of_variables = no_of_inputs + outputs.size();
+
+	/* the cubes are 32 bit wide
+	 */
+	if( no_of_variables > 32 ) {
+		solve_heuristic_per_output();
+		return;
+	}
+
+	unsigned int input_mask = (1u << no_of_inputs) - 1;
+	unsigned int output_mask = ((no_of_variables < 32) ? (1u << no_of_variables) - 1 : ~0u) & ~input_mask;
+	std::vector<SolutionEntries> targets( outputs.size() );
+	SolutionEntries on_set;
+	SolutionEntries dc_set;
+	SolutionEntries off_set;
+	KarnaughData data;
+
+	auto add_cubes = [output_mask]( const SolutionEntries& cubes, unsigned int selector, SolutionEntries& set ) {
+		for( const SolutionEntry& cube : cubes )
+			set.push_back( SolutionEntry( cube.GetMask() | output_mask, cube.GetNumber() | selector ) );
+	};
+
+	/* The single output solver already knows how to turn a table into cubes
+	 */
+	for( unsigned int output = 0; output < outputs.size(); ++output ) {
+		unsigned int selector = 1u << (no_of_inputs + output);
+
+		data.set_table( outputs[output] );
+		targets[output] = data.table_to_cover( target );
+
+		add_cubes( targets[output], selector, on_set );
+		add_cubes( data.table_to_cover( KarnaughData::DONTCARE ), selector, dc_set );
+		add_cubes( data.table_to_cover( other ), selector, off_set );
+	}
+
+	dc_set.push_back( SolutionEntry( output_mask, 0 ) );
+
+	for( unsigned int first = 0; first < outputs.size(); ++first )
+		for( unsigned int second = first + 1; second < outputs.size(); ++second ) {
+			unsigned int pair = (1u << (no_of_inputs + first)) | (1u << (no_of_inputs + second));
+
+			dc_set.push_back( SolutionEntry( pair, pair ) );
+		}
+
+	Espresso engine( no_of_variables );
+	std::map<std::pair<unsigned int, unsigned int>, size_t> products;	// mask, number -> index in the solution
+
+	engine.set_solve_limit( solve_limit );
+
+	SolutionEntries cubes = engine.minimise( on_set, dc_set, off_set );
+
+	cover_statistics.search_truncated = engine.is_stopped();
+
+	for( const SolutionEntry& cube : cubes ) {
+		unsigned int set_outputs = cube.GetNumber() & output_mask;
+		unsigned int free_outputs = output_mask & ~cube.GetMask();
+		unsigned int reached = set_outputs ? set_outputs : free_outputs;
+		SolutionEntry product( cube.GetMask() & input_mask, cube.GetNumber() & input_mask );
+		unsigned int used = 0;
+
+		if( set_outputs & (set_outputs - 1) )		// only don't cares
+			continue;
+
+		/* like in the exact solution, a product only feeds the outputs it covers a target of
+		 */
+		for( unsigned int output = 0; output < outputs.size(); ++output )
+			if( ((reached >> (no_of_inputs + output)) & 1) && std::any_of( targets[output].begin(), targets[output].end(),
+								[&product]( const SolutionEntry& cell ) { return ((cell.GetNumber() ^ product.GetNumber()) & cell.GetMask() & product.GetMask()) == 0; } ) )
+				used |= 1u << output;
+
+		if( !used )
+			continue;
+
+		auto inserted = products.insert( std::make_pair( std::make_pair( product.GetMask(), product.GetNumber() ), the_solution.size() ) );
+
+		if( inserted.second )
+			the_solution.push_back( SharedProduct { product, used } );
+		else
+			the_solution[inserted.first->second].outputs |= used;
+	}
+}
+
+/* Every output on its own, identical products merged
+ */
+void MultiOutputData::solve_heuristic_per_output()
+{
+	std::map<std::pair<unsigned int, unsigned int>, size_t> products;	// mask, number -> index in the solution
+	KarnaughData data;
+
+	data.set_solution_type( solution_type );
+	data.set_solver_mode( KarnaughData::HEURISTIC );
+
+	for( unsigned int output = 0; output < outputs.size(); ++output ) {
+		data.set_table( outputs[output] );
+
+		for( const SolutionEntry& entry : (solve_limit ? data.find_best_solution( *solve_limit ) : data.find_best_solution()) ) {
+			auto inserted = products.insert( std::make_pair( std::make_pair( entry.GetMask(), entry.GetNumber() ), the_solution.size() ) );
+
+			if( inserted.second )
+				the_solution.push_back( SharedProduct { entry, 1U << output } );
+			else
+				the_solution[inserted.first->second].outputs |= 1U << output;
+		}
+
+		cover_statistics.search_truncated = cover_statistics.search_truncated || data.is_solve_stopped();
+	}
+}
+
+SolutionEntries MultiOutputData::get_output_solution( unsigned int output ) const
+{
+	SolutionEntries solution;
+
+	for( const SharedProduct& product : the_solution )
+		if( (product.outputs >> output) & 1 )
+			solution.push_back( product.product );
+
+	return solution;
+}
+
+/* Checks the products of every output against its own table
+ */
+bool MultiOutputData::verify_solution()
+{
+	for( unsigned int output = 0; output < outputs.size(); ++output )
+		if( !verifier.verify( get_output_solution( output ), outputs[output], solution_type == KarnaughData::POS ) )
+			return false;
+
+	return true;
+}
+
+unsigned int MultiOutputData::get_literal_count() const
+{
+	unsigned int literals = 0;
+
+	for( const SharedProduct& product : the_solution )
+		literals += product.product.GetLiteralCount();
+
+	return literals;
+}
@@ -0,0 +1,102 @@
+/*
+ * Copyright 2024 Alwin Leerling <dna.leerling@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#ifndef MULTIOUTPUTDATA_H
+#define MULTIOUTPUTDATA_H
+
+#include <vector>
+
+#include "karnaughdata.h"
+#include "truthtable.h"
+#include "solutionentry.h"
+#include "coversolver.h"
+#include "coververifier.h"
+
+/* A product term together with the outputs it feeds
+ */
+struct SharedProduct
+{
+	SolutionEntry product;
+	unsigned int outputs;				// bit o set when output o uses the product
+};
+
+typedef std::vector<SharedProduct> SharedProducts;
+
+/* Several outputs over the same inputs, minimised together
+ *
+ * The implicants are generated for all outputs at once, each tagged with the set of
+ * outputs it is an implicant of. A multiple output prime is an implicant that can not
+ * grow without losing an output from its tag. The cover then has to cover every target
+ * cell of every output, and a product selected for several outputs counts once.
+ * These charts are a lot harder than single output ones, the cover search stops after
+ * search_node_limit nodes, or at the solve limit if given one, with the best cover it
+ * has found so far. is_solve_stopped() then tells the cover may not be minimal.
+ *
+ * Beyond the exact range all outputs go through one run of the heuristic minimiser, each
+ * output being an extra variable of the cubes. Products are shared wherever the minimiser
+ * finds a cube that serves several outputs. A solve limit that ends the minimiser early
+ * is reported through is_solve_stopped() as well.
+ */
+class MultiOutputData
+{
+public:
+	static const unsigned int max_outputs = 32;
+	static const unsigned long search_node_limit = 20000;
+
+	MultiOutputData();
+
+	void set_dimension( unsigned int no_of_inputs, unsigned int no_of_outputs );
+	void set_value( unsigned int output, unsigned int address, KarnaughData::eCellValues new_value );
+	void set_table( unsigned int output, const TruthTable& table );
+	void set_solution_type( KarnaughData::eSolutionType type );
+
+	unsigned int get_dimension() const { return no_of_inputs; }
+	unsigned int get_outputs() const { return outputs.size(); }
+	KarnaughData::eSolutionType get_solution_type() const { return solution_type; }
+	KarnaughData::eCellValues get_value( unsigned int output, unsigned int address ) const;
+
+	const SharedProducts& find_best_solution();
+	const SharedProducts& find_best_solution( const SolveLimit& limit );
+	SolutionEntries get_output_solution( unsigned int output ) const;
+	bool verify_solution();
+	unsigned int get_literal_count() const;
+
+	bool is_solve_stopped() const { return cover_statistics.search_truncated; }
+	const CoverStatistics& get_cover_statistics() const { return cover_statistics; }
+	const ReductionStatistics& get_reduction_statistics() const { return reduction_statistics; }
+
+private:
+	unsigned int no_of_inputs;
+	std::vector<TruthTable> outputs;
+	KarnaughData::eSolutionType solution_type;
+	SharedProducts the_solution;
+	CoverStatistics cover_statistics;
+	ReductionStatistics reduction_statistics;
+	CoverVerifier verifier;
+	const SolveLimit * solve_limit;		// of the running solve, none solves until done
+
+	bool is_target( unsigned int output, unsigned int address ) const;
+	bool is_allowed( unsigned int output, unsigned int address ) const;
+	SharedProducts find_shared_implicants() const;
+	void solve_exact();
+	void solve_heuristic();
+	void solve_heuristic_per_output();
+};
+
+#endif // MULTIOUTPUTDATA_H
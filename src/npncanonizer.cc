@@ -0,0 +1,217 @@
+/*
+ * Copyright 2024 Alwin Leerling <dna.leerling@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#include "npncanonizer.h"
+
+#include <algorithm>
+#include <utility>
+
+NpnTransform::NpnTransform( unsigned int no_of_inputs ) : no_of_inputs( no_of_inputs ), negation( 0 ), permutation( no_of_inputs )
+{
+	for( unsigned int input = 0; input < no_of_inputs; ++input )
+		permutation[input] = input;
+}
+
+unsigned int NpnTransform::to_canonical( unsigned int address ) const
+{
+	unsigned int result = 0;
+
+	address ^= negation;
+
+	for( unsigned int input = 0; input < no_of_inputs; ++input )
+		result |= ((address >> input) & 1) << permutation[input];
+
+	return result;
+}
+
+SolutionEntry NpnTransform::to_canonical( const SolutionEntry& entry ) const
+{
+	unsigned int mask = 0;
+	unsigned int number = 0;
+	unsigned int flipped = entry.GetNumber() ^ (negation & entry.GetMask());
+
+	for( unsigned int input = 0; input < no_of_inputs; ++input ) {
+		mask |= ((entry.GetMask() >> input) & 1) << permutation[input];
+		number |= ((flipped >> input) & 1) << permutation[input];
+	}
+
+	return SolutionEntry( mask, number );
+}
+
+SolutionEntry NpnTransform::from_canonical( const SolutionEntry& entry ) const
+{
+	unsigned int mask = 0;
+	unsigned int number = 0;
+
+	for( unsigned int input = 0; input < no_of_inputs; ++input ) {
+		mask |= ((entry.GetMask() >> permutation[input]) & 1) << input;
+		number |= ((entry.GetNumber() >> permutation[input]) & 1) << input;
+	}
+
+	return SolutionEntry( mask, number ^ (negation & mask) );
+}
+
+void NpnTransform::sort( SolutionEntries& entries )
+{
+	std::sort( entries.begin(), entries.end(), []( const SolutionEntry& lhs, const SolutionEntry& rhs )
+					{ return (lhs.GetMask() != rhs.GetMask()) ? lhs.GetMask() < rhs.GetMask() : lhs.GetNumber() < rhs.GetNumber(); } );
+}
+
+SolutionEntries NpnTransform::to_canonical( const SolutionEntries& entries ) const
+{
+	SolutionEntries result;
+
+	for( const SolutionEntry& entry : entries )
+		result.push_back( to_canonical( entry ) );
+
+	sort( result );
+
+	return result;
+}
+
+SolutionEntries NpnTransform::from_canonical( const SolutionEntries& entries ) const
+{
+	SolutionEntries result;
+
+	for( const SolutionEntry& entry : entries )
+		result.push_back( from_canonical( entry ) );
+
+	sort( result );
+
+	return result;
+}
+
+NpnCanonizer::NpnCanonizer( unsigned int no_of_inputs )
+{
+	this->no_of_inputs = no_of_inputs;
+	candidates = 0;
+}
+
+void NpnCanonizer::apply( const NpnTransform& transform, const BitVector& cells, BitVector& result ) const
+{
+	result.resize( cells.size() );
+
+	for( size_t address = cells.find_first(); address != BitVector::npos; address = cells.find_next( address + 1 ) )
+		result.set( transform.to_canonical( address ) );
+}
+
+bool NpnCanonizer::is_smaller( const BitVector& lhs_target, const BitVector& lhs_dontcare, const BitVector& rhs_target, const BitVector& rhs_dontcare )
+{
+	if( lhs_target != rhs_target )
+		return lhs_target.get_words() < rhs_target.get_words();
+
+	return lhs_dontcare.get_words() < rhs_dontcare.get_words();
+}
+
+NpnTransform NpnCanonizer::canonize( const BitVector& target, const BitVector& dontcare, BitVector& canonical_target, BitVector& canonical_dontcare )
+{
+	typedef std::pair<size_t, size_t> Counts;		// targets, don't cares
+
+	NpnTransform transform( no_of_inputs );
+	NpnTransform best( no_of_inputs );
+	std::vector<Counts> signature( no_of_inputs );
+	std::vector<unsigned int> order( no_of_inputs );
+	std::vector<unsigned int> phase_ties;
+	Counts total( target.count(), dontcare.count() );
+
+	candidates = 0;
+
+	/* Count what sits in the upper half of every input and put the input in the phase
+	 * with the smaller upper half
+	 */
+	for( unsigned int input = 0; input < no_of_inputs; ++input ) {
+		Counts upper( 0, 0 );
+
+		for( size_t address = target.find_first(); address != BitVector::npos; address = target.find_next( address + 1 ) )
+			upper.first += (address >> input) & 1;
+
+		for( size_t address = dontcare.find_first(); address != BitVector::npos; address = dontcare.find_next( address + 1 ) )
+			upper.second += (address >> input) & 1;
+
+		Counts lower( total.first - upper.first, total.second - upper.second );
+
+		if( lower < upper )
+			transform.negation |= 1 << input;
+		else if( lower == upper )
+			phase_ties.push_back( input );
+
+		signature[input] = std::min( lower, upper );
+		order[input] = input;
+	}
+
+	/* Sort the inputs on their counts, the inputs sharing a count form a group whose
+	 * order is not decided. Each group starts out in ascending input order so stepping
+	 * with next_permutation visits all its orders.
+	 */
+	std::sort( order.begin(), order.end(), [&signature]( unsigned int lhs, unsigned int rhs )
+					{ return (signature[lhs] != signature[rhs]) ? signature[lhs] < signature[rhs] : lhs < rhs; } );
+
+	std::vector<std::pair<unsigned int, unsigned int>> groups;
+
+	for( unsigned int begin = 0, end; begin < no_of_inputs; begin = end ) {
+		for( end = begin + 1; (end < no_of_inputs) && (signature[order[end]] == signature[order[begin]]); ++end )
+			;
+
+		if( end - begin > 1 )
+			groups.push_back( std::make_pair( begin, end ) );
+	}
+
+	BitVector candidate_target;
+	BitVector candidate_dontcare;
+	unsigned int base_negation = transform.negation;
+	bool more_orders = true;
+
+	while( more_orders && (candidates < max_candidates) ) {
+
+		for( unsigned int position = 0; position < no_of_inputs; ++position )
+			transform.permutation[order[position]] = position;
+
+		for( unsigned long phases = 0; (phases < (1UL << phase_ties.size())) && (candidates < max_candidates); ++phases ) {
+
+			transform.negation = base_negation;
+
+			for( unsigned int index = 0; index < phase_ties.size(); ++index )
+				if( phases & (1UL << index) )
+					transform.negation |= 1 << phase_ties[index];
+
+			apply( transform, target, candidate_target );
+			apply( transform, dontcare, candidate_dontcare );
+
+			if( (candidates == 0) || is_smaller( candidate_target, candidate_dontcare, canonical_target, canonical_dontcare ) ) {
+				canonical_target = candidate_target;
+				canonical_dontcare = candidate_dontcare;
+				best = transform;
+			}
+
+			++candidates;
+		}
+
+		/* step to the next order, like an odometer over the groups
+		 */
+		more_orders = false;
+
+		for( const std::pair<unsigned int, unsigned int>& group : groups )
+			if( std::next_permutation( order.begin() + group.first, order.begin() + group.second ) ) {
+				more_orders = true;
+				break;
+			}
+	}
+
+	return best;
+}
@@ -0,0 +1,90 @@
+/*
+ * Copyright 2024 Alwin Leerling <dna.leerling@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#ifndef NPNCANONIZER_H
+#define NPNCANONIZER_H
+
+#include <vector>
+
+#include "solutionentry.h"
+#include "bitvector.h"
+
+/* Input negation and permutation taking a function to its class representative
+ *
+ * An input address is first negated on the inputs in negation, then input i moves to
+ * position permutation[i]. Cubes map the same way, the negation only applies to their
+ * fixed variables. Both directions keep the number of cubes and literals, so a minimum
+ * cover of the representative maps back to a minimum cover of the function.
+ */
+class NpnTransform
+{
+public:
+	explicit NpnTransform( unsigned int no_of_inputs );
+
+	unsigned int to_canonical( unsigned int address ) const;
+	SolutionEntry to_canonical( const SolutionEntry& entry ) const;
+	SolutionEntry from_canonical( const SolutionEntry& entry ) const;
+
+	SolutionEntries to_canonical( const SolutionEntries& entries ) const;
+	SolutionEntries from_canonical( const SolutionEntries& entries ) const;
+
+private:
+	friend class NpnCanonizer;
+
+	unsigned int no_of_inputs;
+	unsigned int negation;
+	std::vector<unsigned int> permutation;
+
+	static void sort( SolutionEntries& entries );
+};
+
+/* Maps a target set and don't care set to the representative of its NPN class
+ *
+ * Output negation is left to the caller: covering the zeroes of a function is the same
+ * problem as covering the ones of its complement, so passing the cells to be covered as
+ * the target set already folds it in.
+ *
+ * Every input is first put in the phase with the fewest targets (don't cares break ties)
+ * in its upper half, then the inputs are sorted on these counts. Both steps commute with
+ * any NPN transform, so only inputs with equal counts are ambiguous. All orders and
+ * phases of those are tried and the smallest resulting table is the representative.
+ * When there are more than max_candidates to try (highly symmetric functions) only the
+ * first ones are, equivalent functions may then end up with different representatives.
+ */
+class NpnCanonizer
+{
+public:
+	static const unsigned int max_inputs = 16;
+	static const unsigned long max_candidates = 64;
+
+	explicit NpnCanonizer( unsigned int no_of_inputs );
+
+	NpnTransform canonize( const BitVector& target, const BitVector& dontcare, BitVector& canonical_target, BitVector& canonical_dontcare );
+
+	unsigned long get_candidates() const { return candidates; }
+
+private:
+	unsigned int no_of_inputs;
+	unsigned long candidates;
+
+	void apply( const NpnTransform& transform, const BitVector& cells, BitVector& result ) const;
+	static bool is_smaller( const BitVector& lhs_target, const BitVector& lhs_dontcare, const BitVector& rhs_target, const BitVector& rhs_dontcare );
+};
+
+#endif // NPNCANONIZER_H
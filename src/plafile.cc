@@ -0,0 +1,292 @@
+/*
+ * Copyright 2024 Alwin Leerling <dna.leerling@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#include "plafile.h"
+
+#include <sstream>
+#include <cstdlib>
+
+#include "tracer.h"
+
+enum eSet { ON_SET, OFF_SET, DC_SET };
+
+PlaFile::PlaFile()
+{
+	has_inputs = false;
+	no_of_inputs = 0;
+	no_of_outputs = 0;
+	type = FD;
+	no_of_products = 0;
+}
+
+bool PlaFile::fail( unsigned int line, const std::string& message )
+{
+	std::ostringstream text;
+
+	text << "line " << line << ": " << message;
+	error = text.str();
+
+	return false;
+}
+
+bool PlaFile::read( std::istream& input )
+{
+	TraceSpan span( "PlaFile::read" );
+	std::vector<SolutionEntries> sets[3];
+	std::string text;
+	unsigned int line = 0;
+
+	has_inputs = false;
+	no_of_inputs = 0;
+	no_of_outputs = 0;
+	type = FD;
+	no_of_products = 0;
+	input_labels.clear();
+	output_labels.clear();
+	tables.clear();
+	error.clear();
+
+	while( std::getline( input, text ) ) {
+		++line;
+
+		text = text.substr( 0, text.find( '#' ) );
+
+		std::istringstream stream( text );
+		std::vector<std::string> words;
+		std::string word;
+
+		while( stream >> word )
+			words.push_back( word );
+
+		if( words.empty() )
+			continue;
+
+		if( words[0][0] == '.' ) {
+			if( (words[0] == ".e") || (words[0] == ".end") )
+				break;
+
+			if( !read_directive( line, words ) )
+				return false;
+
+			continue;
+		}
+
+		/* the input and output part may or may not be separated by spaces
+		 */
+		std::string cells;
+
+		for( const std::string& part : words )
+			cells += part;
+
+		if( !read_product( line, cells, sets ) )
+			return false;
+	}
+
+	if( !has_inputs )
+		return fail( line, "no .i given" );
+
+	if( no_of_outputs == 0 )
+		no_of_outputs = 1;
+
+	build_tables( sets );
+
+	return true;
+}
+
+bool PlaFile::read_directive( unsigned int line, const std::vector<std::string>& words )
+{
+	const std::string& directive = words[0];
+
+	if( (directive == ".i") || (directive == ".o") ) {
+		if( no_of_products != 0 )
+			return fail( line, directive + " after the first product" );
+
+		unsigned int limit = (directive == ".i") ? max_inputs : MultiOutputData::max_outputs;
+		unsigned int count = (words.size() > 1) ? std::strtoul( words[1].c_str(), nullptr, 10 ) : 0;
+
+		if( (words.size() != 2) || (count > limit) || ((directive == ".o") && (count == 0)) )
+			return fail( line, directive + " needs a count up to " + std::to_string( limit ) );
+
+		if( directive == ".i" ) {
+			has_inputs = true;
+			no_of_inputs = count;
+		} else
+			no_of_outputs = count;
+
+		return true;
+	}
+
+	if( directive == ".ilb" ) {
+		input_labels.assign( words.begin() + 1, words.end() );
+		return true;
+	}
+
+	if( directive == ".ob" ) {
+		output_labels.assign( words.begin() + 1, words.end() );
+		return true;
+	}
+
+	if( directive == ".type" ) {
+		std::string name = (words.size() > 1) ? words[1] : "";
+
+		if( name == "f" )
+			type = F;
+		else if( name == "fd" )
+			type = FD;
+		else if( name == "fr" )
+			type = FR;
+		else if( name == "fdr" )
+			type = FDR;
+		else
+			return fail( line, "unknown .type " + name );
+
+		return true;
+	}
+
+	/* .p only announces the number of products, others (.phase, .pair) do not apply here
+	 */
+	return true;
+}
+
+bool PlaFile::read_product( unsigned int line, const std::string& cells, std::vector<SolutionEntries> sets[3] )
+{
+	if( !has_inputs )
+		return fail( line, "product before .i" );
+
+	if( no_of_outputs == 0 )
+		no_of_outputs = 1;
+
+	if( cells.size() != no_of_inputs + no_of_outputs )
+		return fail( line, "expected " + std::to_string( no_of_inputs ) + " inputs and " + std::to_string( no_of_outputs ) + " outputs" );
+
+	unsigned int mask = 0;
+	unsigned int number = 0;
+
+	for( unsigned int column = 0; column < no_of_inputs; ++column ) {
+		unsigned int bit = 1u << (no_of_inputs - 1 - column);
+
+		switch( cells[column] ) {
+		case '0': mask |= bit; break;
+		case '1': mask |= bit; number |= bit; break;
+		case '-':
+		case '2': break;
+		default: return fail( line, std::string( "invalid input value " ) + cells[column] );
+		}
+	}
+
+	for( unsigned int set = ON_SET; set <= DC_SET; ++set )
+		sets[set].resize( no_of_outputs );
+
+	for( unsigned int output = 0; output < no_of_outputs; ++output ) {
+		switch( cells[no_of_inputs + output] ) {
+		case '1':
+		case '4': sets[ON_SET][output].push_back( SolutionEntry( mask, number ) ); break;
+		case '0': sets[OFF_SET][output].push_back( SolutionEntry( mask, number ) ); break;
+		case '-':
+		case '2': sets[DC_SET][output].push_back( SolutionEntry( mask, number ) ); break;
+		case '~':
+		case '3': break;
+		default: return fail( line, std::string( "invalid output value " ) + cells[no_of_inputs + output] );
+		}
+	}
+
+	++no_of_products;
+
+	return true;
+}
+
+void PlaFile::build_tables( std::vector<SolutionEntries> sets[3] )
+{
+	unsigned int no_of_cells = 1u << no_of_inputs;
+
+	for( unsigned int set = ON_SET; set <= DC_SET; ++set )
+		sets[set].resize( no_of_outputs );
+
+	tables.assign( no_of_outputs, TruthTable() );
+
+	for( unsigned int output = 0; output < no_of_outputs; ++output ) {
+		BitVector ones = SolutionEntry::GetCoverage( sets[ON_SET][output], no_of_cells );
+		BitVector dontcares = SolutionEntry::GetCoverage( sets[DC_SET][output], no_of_cells );
+
+		if( type == F )
+			dontcares.clear();
+
+		/* with an explicit OFF-set whatever is in no set is free
+		 */
+		if( (type == FR) || (type == FDR) ) {
+			BitVector unspecified( no_of_cells );
+
+			unspecified.fill();
+			unspecified.remove( ones );
+			unspecified.remove( SolutionEntry::GetCoverage( sets[OFF_SET][output], no_of_cells ) );
+
+			if( type == FR )
+				dontcares = unspecified;
+			else
+				dontcares |= unspecified;
+		}
+
+		tables[output].resize( no_of_inputs );
+		tables[output].assign( ones, dontcares );
+	}
+}
+
+void PlaFile::write( std::ostream& output, const SharedProducts& products ) const
+{
+	TraceSpan span( "PlaFile::write" );
+
+	output << ".i " << no_of_inputs << "\n";
+	output << ".o " << no_of_outputs << "\n";
+
+	if( !input_labels.empty() ) {
+		output << ".ilb";
+		for( const std::string& label : input_labels )
+			output << " " << label;
+		output << "\n";
+	}
+
+	if( !output_labels.empty() ) {
+		output << ".ob";
+		for( const std::string& label : output_labels )
+			output << " " << label;
+		output << "\n";
+	}
+
+	output << ".p " << products.size() << "\n";
+
+	std::string line( no_of_inputs + 1 + no_of_outputs, ' ' );
+
+	for( const SharedProduct& product : products ) {
+		unsigned int mask = product.product.GetMask();
+		unsigned int number = product.product.GetNumber();
+
+		for( unsigned int column = 0; column < no_of_inputs; ++column ) {
+			unsigned int bit = 1u << (no_of_inputs - 1 - column);
+
+			line[column] = !(mask & bit) ? '-' : (number & bit) ? '1' : '0';
+		}
+
+		for( unsigned int index = 0; index < no_of_outputs; ++index )
+			line[no_of_inputs + 1 + index] = ((product.outputs >> index) & 1) ? '1' : '0';
+
+		output << line << "\n";
+	}
+
+	output << ".e\n";
+}
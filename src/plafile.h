@@ -0,0 +1,81 @@
+/*
+ * Copyright 2024 Alwin Leerling <dna.leerling@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#ifndef PLAFILE_H
+#define PLAFILE_H
+
+#include <vector>
+#include <string>
+#include <istream>
+#include <ostream>
+
+#include "truthtable.h"
+#include "solutionentry.h"
+#include "multioutputdata.h"
+
+/* Berkeley PLA files
+ *
+ * A file lists product terms, each an input cube of 0, 1 and - followed by an output
+ * part saying per output whether the cube is in its ON-set (1), OFF-set (0) or
+ * don't care set (- or 2); ~ leaves an output alone (espresso also writes 4 and 3 for
+ * 1 and ~). Which of those parts count depends on the .type: f only has ON-sets, fd
+ * adds don't cares, fr gives ON- and OFF-sets and fdr all three. Whatever a file leaves
+ * unspecified is a zero for f and fd, a don't care for fr and fdr. A cell that ends up
+ * in the ON-set and another set is a one.
+ *
+ * The first input column is the highest address bit, the way a truth table is written.
+ * read() turns the file into one truth table per output, write() puts out a cover as
+ * a PLA of type f keeping the labels of the file read.
+ */
+class PlaFile
+{
+public:
+	enum eType { F, FD, FR, FDR };
+
+	static const unsigned int max_inputs = 24;		// the tables take 2^inputs cells
+
+	PlaFile();
+
+	bool read( std::istream& input );
+	void write( std::ostream& output, const SharedProducts& products ) const;
+
+	unsigned int get_inputs() const { return no_of_inputs; }
+	unsigned int get_outputs() const { return no_of_outputs; }
+	size_t get_product_count() const { return no_of_products; }
+	const TruthTable& get_table( unsigned int output ) const { return tables[output]; }
+	const std::string& get_error() const { return error; }
+
+private:
+	bool has_inputs;						// .i seen
+	unsigned int no_of_inputs;
+	unsigned int no_of_outputs;
+	eType type;
+	size_t no_of_products;
+	std::vector<std::string> input_labels;
+	std::vector<std::string> output_labels;
+	std::vector<TruthTable> tables;
+	std::string error;
+
+	bool fail( unsigned int line, const std::string& message );
+	bool read_directive( unsigned int line, const std::vector<std::string>& words );
+	bool read_product( unsigned int line, const std::string& cells, std::vector<SolutionEntries> sets[3] );
+	void build_tables( std::vector<SolutionEntries> sets[3] );
+};
+
+#endif // PLAFILE_H
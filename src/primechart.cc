@@ -0,0 +1,249 @@
+/*
+ * Copyright 2024 Alwin Leerling <dna.leerling@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#include "primechart.h"
+
+PrimeChart::PrimeChart()
+{
+	no_of_rows = 0;
+	no_of_columns = 0;
+	statistics = ReductionStatistics { 0, 0, 0, 0, 0, 0, 0 };
+}
+
+PrimeChart::PrimeChart( const SolutionEntries& primes, const std::vector<unsigned int>& minterms )
+{
+	assign( primes, minterms );
+}
+
+void PrimeChart::assign( const SolutionEntries& primes, const std::vector<unsigned int>& minterms )
+{
+	no_of_rows = primes.size();
+	no_of_columns = minterms.size();
+
+	/* only grown, the sets beyond the counts keep their memory for a later chart
+	 */
+	if( rows.size() < no_of_rows )
+		rows.resize( no_of_rows );
+
+	if( columns.size() < no_of_columns )
+		columns.resize( no_of_columns );
+
+	for( unsigned int row = 0; row < no_of_rows; ++row )
+		rows[row].resize( no_of_columns );
+
+	for( unsigned int column = 0; column < no_of_columns; ++column )
+		columns[column].resize( no_of_rows );
+
+	row_costs.clear();
+
+	state.active_rows.resize( no_of_rows );
+	state.active_columns.resize( no_of_columns );
+	state.active_columns.fill();
+	state.selected_rows.clear();
+
+	statistics = ReductionStatistics { 0, 0, 0, 0, 0, 0, 0 };
+
+	for( unsigned int row = 0; row < no_of_rows; ++row ) {
+
+		for( unsigned int column = 0; column < no_of_columns; ++column ) {
+			if( (minterms[column] & primes[row].GetMask()) == primes[row].GetNumber() ) {
+				rows[row].set( column );
+				columns[column].set( row );
+			}
+		}
+
+		/* a prime spanning don't cares only is of no use to any cover
+		 */
+		if( !rows[row].none() )
+			state.active_rows.set( row );
+
+		row_costs.push_back( primes[row].GetLiteralCount() );
+	}
+}
+
+PrimeChart::PrimeChart( const std::vector<BitVector>& rows, const std::vector<unsigned int>& row_costs, unsigned int no_of_columns )
+	: no_of_rows( rows.size() ), no_of_columns( no_of_columns ), rows( rows ), row_costs( row_costs )
+{
+	columns.resize( no_of_columns, BitVector( rows.size() ) );
+
+	state.active_rows.resize( rows.size() );
+	state.active_columns.resize( no_of_columns );
+	state.active_columns.fill();
+
+	statistics = ReductionStatistics { 0, 0, 0, 0, 0, 0, 0 };
+
+	for( unsigned int row = 0; row < rows.size(); ++row ) {
+
+		for( size_t column = rows[row].find_first(); column != BitVector::npos; column = rows[row].find_next( column + 1 ) )
+			columns[column].set( row );
+
+		if( !rows[row].none() )
+			state.active_rows.set( row );
+	}
+}
+
+void PrimeChart::reduce()
+{
+	reduce( state, statistics, buffers );
+}
+
+void PrimeChart::reduce( ChartState& state, ReductionStatistics& statistics, ReductionBuffers& buffers ) const
+{
+	bool changed = true;
+
+	while( changed ) {
+		++statistics.iterations;
+
+		changed = select_essential_rows( state, statistics, buffers );
+		changed = remove_dominated_rows( state, statistics, buffers ) || changed;
+		changed = remove_dominated_columns( state, statistics, buffers ) || changed;
+	}
+
+	statistics.core_rows = state.active_rows.count();
+	statistics.core_columns = state.active_columns.count();
+}
+
+bool PrimeChart::select_essential_rows( ChartState& state, ReductionStatistics& statistics, ReductionBuffers& buffers ) const
+{
+	BitVector& active_rows = state.active_rows;
+	BitVector& active_columns = state.active_columns;
+	bool changed = false;
+	BitVector& covering = buffers.covering;
+	BitVector& covered = buffers.covered;
+
+	/* A column with only one row left makes that row essential
+	 */
+	for( size_t column = active_columns.find_first(); column != BitVector::npos; column = active_columns.find_next( column + 1 ) ) {
+
+		covering = columns[column];
+		covering &= active_rows;
+
+		if( covering.count() != 1 )
+			continue;
+
+		unsigned int row = covering.find_first();
+
+		covered = rows[row];
+		covered &= active_columns;
+
+		state.selected_rows.push_back( row );
+		active_rows.reset( row );
+		active_columns.remove( covered );
+
+		++statistics.essential_rows;
+		statistics.covered_columns += covered.count();
+		changed = true;
+	}
+
+	return changed;
+}
+
+bool PrimeChart::remove_dominated_rows( ChartState& state, ReductionStatistics& statistics, ReductionBuffers& buffers ) const
+{
+	BitVector& active_rows = state.active_rows;
+	const BitVector& active_columns = state.active_columns;
+	bool changed = false;
+	std::vector<unsigned int>& candidates = buffers.candidates;
+	std::vector<BitVector>& coverage = buffers.coverage;
+
+	candidates.clear();
+	if( coverage.size() < no_of_rows )
+		coverage.resize( no_of_rows );
+
+	for( size_t row = active_rows.find_first(); row != BitVector::npos; row = active_rows.find_next( row + 1 ) ) {
+		coverage[row] = rows[row];
+		coverage[row] &= active_columns;
+
+		if( coverage[row].none() ) {					// nothing left to cover for this row
+			active_rows.reset( row );
+			++statistics.dominated_rows;
+			changed = true;
+		} else
+			candidates.push_back( row );
+	}
+
+	/* A row is dominated when another row covers the same columns (and maybe more) at no
+	 * higher cost. Dropping it can not make a cover worse. Of two identical rows the one
+	 * with the lowest index is kept.
+	 */
+	for( unsigned int row : candidates ) {
+		for( unsigned int other : candidates ) {
+
+			if( (other == row) || !active_rows.test( other ) || (row_costs[other] > row_costs[row]) )
+				continue;
+
+			if( !coverage[row].is_subset_of( coverage[other] ) )
+				continue;
+
+			if( (row_costs[other] == row_costs[row]) && (coverage[row] == coverage[other]) && (other > row) )
+				continue;
+
+			active_rows.reset( row );
+			++statistics.dominated_rows;
+			changed = true;
+			break;
+		}
+	}
+
+	return changed;
+}
+
+bool PrimeChart::remove_dominated_columns( ChartState& state, ReductionStatistics& statistics, ReductionBuffers& buffers ) const
+{
+	const BitVector& active_rows = state.active_rows;
+	BitVector& active_columns = state.active_columns;
+	bool changed = false;
+	std::vector<unsigned int>& candidates = buffers.candidates;
+	std::vector<BitVector>& coverage = buffers.coverage;
+
+	candidates.clear();
+	if( coverage.size() < no_of_columns )
+		coverage.resize( no_of_columns );
+
+	for( size_t column = active_columns.find_first(); column != BitVector::npos; column = active_columns.find_next( column + 1 ) ) {
+		coverage[column] = columns[column];
+		coverage[column] &= active_rows;
+		candidates.push_back( column );
+	}
+
+	/* A column is dominated when every row covering some other column covers it as well.
+	 * Covering the other column then covers this one for free. Of two identical columns
+	 * the one with the lowest index is kept.
+	 */
+	for( unsigned int column : candidates ) {
+		for( unsigned int other : candidates ) {
+
+			if( (other == column) || !active_columns.test( other ) )
+				continue;
+
+			if( !coverage[other].is_subset_of( coverage[column] ) )
+				continue;
+
+			if( (coverage[other] == coverage[column]) && (other > column) )
+				continue;
+
+			active_columns.reset( column );
+			++statistics.dominated_columns;
+			changed = true;
+			break;
+		}
+	}
+
+	return changed;
+}
@@ -0,0 +1,122 @@
+/*
+ * Copyright 2024 Alwin Leerling <dna.leerling@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#ifndef PRIMECHART_H
+#define PRIMECHART_H
+
+#include <vector>
+
+#include "solutionentry.h"
+#include "bitvector.h"
+
+struct ReductionStatistics
+{
+	unsigned int iterations;			// passes until nothing changed anymore
+	unsigned int essential_rows;		// rows selected because a column had no other row
+	unsigned int covered_columns;		// columns removed because an essential row covers them
+	unsigned int dominated_rows;		// rows removed because another row covers at least as much for no more cost
+	unsigned int dominated_columns;		// columns removed because covering another column covers them as well
+	unsigned int core_rows;				// rows left in the cyclic core
+	unsigned int core_columns;			// columns left in the cyclic core
+};
+
+/* The part of a chart still under consideration
+ */
+struct ChartState
+{
+	BitVector active_rows;
+	BitVector active_columns;
+	std::vector<unsigned int> selected_rows;
+};
+
+/* Memory of the reductions
+ *
+ * Reducing a state needs a few sets of its own. They come from here, so a search that
+ * reduces many states, or a chart that is refilled, reuses them instead of allocating.
+ */
+struct ReductionBuffers
+{
+	BitVector covering;
+	BitVector covered;
+	std::vector<unsigned int> candidates;
+	std::vector<BitVector> coverage;
+};
+
+/* Prime implicant chart
+ *
+ * Every row is a prime implicant, every column a minterm that needs to be covered.
+ * Charts of other covering problems (like the multiple output one) can be given as
+ * their rows directly.
+ * A row is stored as the set of columns it covers, a column as the set of rows covering it.
+ * The cost of a row is its literal count, used to break ties between equally sized covers.
+ *
+ * Rows and columns can be taken out of consideration. Rows that are known to be part of
+ * every cover are recorded as selected.
+ *
+ * reduce() repeatedly selects the essential rows and drops dominated rows and columns
+ * until the chart does not change anymore. What is left is the cyclic core, which is
+ * empty for most charts. The same reductions can be applied to any other state of the
+ * chart, as done by the cover search on its subproblems, with buffers of the caller.
+ *
+ * assign() fills a chart again for other primes and minterms. The sets of the rows and
+ * columns are overwritten in place and never given back, a chart kept from one solve to
+ * the next stops allocating once it has held the largest one.
+ */
+class PrimeChart
+{
+public:
+	PrimeChart();
+	PrimeChart( const SolutionEntries& primes, const std::vector<unsigned int>& minterms );
+	PrimeChart( const std::vector<BitVector>& rows, const std::vector<unsigned int>& row_costs, unsigned int no_of_columns );
+
+	void assign( const SolutionEntries& primes, const std::vector<unsigned int>& minterms );
+
+	unsigned int get_row_count() const { return no_of_rows; }
+	unsigned int get_column_count() const { return no_of_columns; }
+
+	const BitVector& get_row( unsigned int row ) const { return rows[row]; }
+	const BitVector& get_column( unsigned int column ) const { return columns[column]; }
+	unsigned int get_row_cost( unsigned int row ) const { return row_costs[row]; }
+
+	const ChartState& get_state() const { return state; }
+	const BitVector& get_active_rows() const { return state.active_rows; }
+	const BitVector& get_active_columns() const { return state.active_columns; }
+	const std::vector<unsigned int>& get_selected_rows() const { return state.selected_rows; }
+
+	void reduce();
+	void reduce( ChartState& state, ReductionStatistics& statistics, ReductionBuffers& buffers ) const;
+	const ReductionStatistics& get_statistics() const { return statistics; }
+
+private:
+	unsigned int no_of_rows;
+	unsigned int no_of_columns;
+	std::vector<BitVector> rows;			// the first no_of_rows are in use
+	std::vector<BitVector> columns;			// the first no_of_columns are in use
+	std::vector<unsigned int> row_costs;
+
+	ChartState state;
+	ReductionStatistics statistics;
+	ReductionBuffers buffers;
+
+	bool select_essential_rows( ChartState& state, ReductionStatistics& statistics, ReductionBuffers& buffers ) const;
+	bool remove_dominated_rows( ChartState& state, ReductionStatistics& statistics, ReductionBuffers& buffers ) const;
+	bool remove_dominated_columns( ChartState& state, ReductionStatistics& statistics, ReductionBuffers& buffers ) const;
+};
+
+#endif // PRIMECHART_H
@@ -0,0 +1,261 @@
+/*
+ * Copyright 2024 Alwin Leerling <dna.leerling@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#include "quinemccluskey.h"
+
+#include <algorithm>
+#include <bitset>
+
+static unsigned int ones_count( unsigned int number )
+{
+	return std::bitset<32>( number ).count();
+}
+
+/* Order of the returned primes, by mask then by number
+ */
+static bool prime_order( const SolutionEntry& lhs, const SolutionEntry& rhs )
+{
+	return (lhs.GetMask() != rhs.GetMask()) ? lhs.GetMask() < rhs.GetMask() : lhs.GetNumber() < rhs.GetNumber();
+}
+
+static bool contains( const SolutionEntry& outer, const SolutionEntry& inner )
+{
+	return ((outer.GetMask() & ~inner.GetMask()) == 0) && ((inner.GetNumber() & outer.GetMask()) == outer.GetNumber());
+}
+
+QuineMcCluskey::QuineMcCluskey( unsigned int no_of_inputs )
+{
+	this->no_of_inputs = no_of_inputs;
+	comparisons = 0;
+	merges = 0;
+	duplicates = 0;
+}
+
+SolutionEntries QuineMcCluskey::find_prime_implicants( const std::vector<unsigned int>& addresses )
+{
+	SolutionEntries primes;
+	ImplicantStore level;
+	ImplicantStore next_level;
+
+	find_prime_implicants( addresses, level, next_level, primes );
+
+	return primes;
+}
+
+void QuineMcCluskey::find_prime_implicants( const std::vector<unsigned int>& addresses, ImplicantStore& level, ImplicantStore& next_level, SolutionEntries& primes )
+{
+	unsigned int mask = (1 << no_of_inputs) - 1;
+
+	comparisons = 0;
+	merges = 0;
+	duplicates = 0;
+
+	primes.clear();
+	level.clear();
+
+	level.reserve( addresses.size() );
+	for( unsigned int address : addresses )
+		level.push_back( mask, address );
+
+	level.sort_unique();
+
+	/* Every pass combines the implicants of one level into the next (one more free variable)
+	 * Whatever did not combine with anything is prime.
+	 */
+	while( !level.empty() ) {
+
+		next_level.clear();
+
+		combine_level( level, next_level );
+
+		for( size_t index = 0; index < level.size(); ++index )
+			if( !level.is_marked( index ) )
+				primes.push_back( level.get_entry( index ) );
+
+		/* The same implicant is created once for every pair of halves it can be split into
+		 */
+		size_t made = next_level.size();
+
+		next_level.sort_unique();
+		duplicates += made - next_level.size();
+
+		level.swap( next_level );
+	}
+
+	std::sort( primes.begin(), primes.end(), prime_order );
+}
+
+void QuineMcCluskey::combine_level( ImplicantStore& level, ImplicantStore& next_level )
+{
+	size_t group_begin = 0;
+
+	while( group_begin != level.size() ) {
+
+		/* find the end of this mask group, and within it walk the buckets pairwise
+		 */
+		size_t group_end = group_begin;
+		while( (group_end != level.size()) && (level.get_mask( group_end ) == level.get_mask( group_begin )) )
+			++group_end;
+
+		size_t lower_begin = group_begin;
+
+		while( lower_begin != group_end ) {
+
+			unsigned int lower_ones = ones_count( level.get_number( lower_begin ) );
+
+			size_t lower_end = lower_begin;
+			while( (lower_end != group_end) && (ones_count( level.get_number( lower_end ) ) == lower_ones) )
+				++lower_end;
+
+			if( lower_end == group_end )
+				break;
+
+			size_t upper_end = lower_end;
+			while( (upper_end != group_end) && (ones_count( level.get_number( upper_end ) ) == lower_ones + 1) )
+				++upper_end;
+
+			if( upper_end != lower_end )
+				combine_buckets( level, lower_begin, lower_end, lower_end, upper_end, next_level );
+
+			lower_begin = lower_end;
+		}
+
+		group_begin = group_end;
+	}
+}
+
+void QuineMcCluskey::combine_buckets( ImplicantStore& level, size_t lower_begin, size_t lower_end, size_t upper_begin, size_t upper_end, ImplicantStore& next_level )
+{
+	for( size_t lower = lower_begin; lower != lower_end; ++lower ) {
+
+		unsigned int mask = level.get_mask( lower );
+		unsigned int number = level.get_number( lower );
+
+		comparisons += upper_end - upper_begin;
+
+		/* Both buckets share the mask and differ by exactly one in their ones count, so a
+		 * single bit difference means upper is lower with one extra bit set
+		 */
+		for( size_t upper = upper_begin; upper != upper_end; ++upper ) {
+
+			unsigned int xor_number = number ^ level.get_number( upper );
+
+			if( xor_number & (xor_number - 1) )
+				continue;
+
+			next_level.push_back( mask & ~xor_number, number & ~xor_number );
+			level.mark( lower );
+			level.mark( upper );
+			++merges;
+		}
+	}
+}
+
+void QuineMcCluskey::insert_address( SolutionEntries& primes, const BitVector& addresses, unsigned int address )
+{
+	unsigned int mask = (1 << no_of_inputs) - 1;
+	std::vector<bool> valid( 1 << no_of_inputs, false );
+	SolutionEntries grown;
+
+	/* Every implicant that did not exist before contains the new address. They are the
+	 * cubes around it, one for every set of free variables whose cells are all in the
+	 * function. The cubes one free variable smaller hold every cell but the one opposite
+	 * the address, counting up through the sets visits those smaller cubes first.
+	 */
+	for( unsigned int free = 0; free <= mask; ++free ) {
+
+		bool candidate = true;
+
+		for( unsigned int rest = free; rest && candidate; rest &= rest - 1 )
+			candidate = valid[free & ~(rest & (~rest + 1))];
+
+		valid[free] = candidate && addresses.test( address ^ free );
+
+		++comparisons;
+	}
+
+	/* The largest of these cubes are the new primes, an old prime inside one of them is
+	 * not prime anymore
+	 */
+	for( unsigned int free = 0; free <= mask; ++free ) {
+
+		if( !valid[free] )
+			continue;
+
+		bool maximal = true;
+		for( unsigned int bit = 1; (bit <= mask) && maximal; bit <<= 1 )
+			maximal = (free & bit) || !valid[free | bit];
+
+		if( maximal )
+			grown.push_back( SolutionEntry( mask & ~free, address & ~free ) );
+	}
+
+	primes.erase( std::remove_if( primes.begin(), primes.end(), [&grown]( const SolutionEntry& prime ) {
+						return std::any_of( grown.begin(), grown.end(), [&prime]( const SolutionEntry& cube ) { return contains( cube, prime ); } );
+					} ), primes.end() );
+
+	merges += grown.size();
+	primes.insert( primes.end(), grown.begin(), grown.end() );
+	std::sort( primes.begin(), primes.end(), prime_order );
+}
+
+void QuineMcCluskey::erase_address( SolutionEntries& primes, unsigned int address )
+{
+	unsigned int mask = (1 << no_of_inputs) - 1;
+	SolutionEntries untouched;
+	SolutionEntries split;
+
+	/* A prime containing the address falls apart into the halves that avoid it, one for
+	 * each of its free variables. Every implicant left inside the old prime is inside one
+	 * of those halves, so the new primes are the largest of the halves that no untouched
+	 * prime already contains.
+	 */
+	for( const SolutionEntry& prime : primes ) {
+
+		if( (address & prime.GetMask()) != prime.GetNumber() ) {
+			untouched.push_back( prime );
+			continue;
+		}
+
+		for( unsigned int bit = 1; bit <= mask; bit <<= 1 )
+			if( !(prime.GetMask() & bit) )
+				split.push_back( SolutionEntry( prime.GetMask() | bit, prime.GetNumber() | (~address & bit) ) );
+	}
+
+	std::sort( split.begin(), split.end(), prime_order );
+	split.erase( std::unique( split.begin(), split.end() ), split.end() );
+
+	primes = untouched;
+
+	for( const SolutionEntry& half : split ) {
+
+		comparisons += untouched.size() + split.size();
+
+		if( std::any_of( untouched.begin(), untouched.end(), [&half]( const SolutionEntry& prime ) { return contains( prime, half ); } ) )
+			continue;
+
+		if( std::any_of( split.begin(), split.end(), [&half]( const SolutionEntry& other ) { return (other != half) && contains( other, half ); } ) )
+			continue;
+
+		primes.push_back( half );
+		++merges;
+	}
+
+	std::sort( primes.begin(), primes.end(), prime_order );
+}
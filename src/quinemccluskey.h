@@ -0,0 +1,68 @@
+/*
+ * Copyright 2024 Alwin Leerling <dna.leerling@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#ifndef QUINEMCCLUSKEY_H
+#define QUINEMCCLUSKEY_H
+
+#include <vector>
+
+#include "solutionentry.h"
+#include "bitvector.h"
+#include "implicantstore.h"
+
+/* Tabulation engine producing the prime implicants of a set of minterms.
+ *
+ * Implicants are kept per level (a level holds all implicants with the same number of
+ * free variables), grouped by mask and within a mask group bucketed by the number of
+ * ones in the implicant number. Two implicants can only combine when they share a mask
+ * and their ones count differs by exactly one, so only adjacent buckets are compared.
+ * The levels live in an ImplicantStore.
+ *
+ * A set of primes can also be updated in place when a single address enters or leaves
+ * the function, which only touches the primes containing or absorbed around that address.
+ * The updated set is ordered exactly like the one find_prime_implicants returns.
+ *
+ * The solvers get their primes from FixedQuineMcCluskey, this engine serves the in place
+ * updates and is the reference the fixed kernel is checked against.
+ */
+class QuineMcCluskey
+{
+public:
+	explicit QuineMcCluskey( unsigned int no_of_inputs );
+
+	SolutionEntries find_prime_implicants( const std::vector<unsigned int>& addresses );
+	void insert_address( SolutionEntries& primes, const BitVector& addresses, unsigned int address );
+	void erase_address( SolutionEntries& primes, unsigned int address );
+
+	unsigned long get_comparisons() const { return comparisons; }
+	unsigned long get_merges() const { return merges; }
+	unsigned long get_duplicates() const { return duplicates; }
+
+private:
+	unsigned int no_of_inputs;
+	unsigned long comparisons;
+	unsigned long merges;
+	unsigned long duplicates;				// merges that made an implicant already made
+
+	void find_prime_implicants( const std::vector<unsigned int>& addresses, ImplicantStore& level, ImplicantStore& next_level, SolutionEntries& primes );
+	void combine_level( ImplicantStore& level, ImplicantStore& next_level );
+	void combine_buckets( ImplicantStore& level, size_t lower_begin, size_t lower_end, size_t upper_begin, size_t upper_end, ImplicantStore& next_level );
+};
+
+#endif // QUINEMCCLUSKEY_H
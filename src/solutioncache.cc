@@ -0,0 +1,136 @@
+/*
+ * Copyright 2024 Alwin Leerling <dna.leerling@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#include "solutioncache.h"
+
+SolutionCache::SolutionCache( size_t capacity )
+{
+	this->capacity = capacity;
+	size = 0;
+	hits = 0;
+	misses = 0;
+	evictions = 0;
+}
+
+uint64_t SolutionCache::hash( const std::vector<uint64_t>& key )
+{
+	uint64_t result = 0xcbf29ce484222325ULL;
+
+	/* FNV style mixing of whole words, each word is scrambled first so neighbouring
+	 * tables (one bit apart) end up far apart
+	 */
+	for( uint64_t word : key ) {
+		word ^= word >> 33;
+		word *= 0xff51afd7ed558ccdULL;
+		word ^= word >> 33;
+
+		result = (result ^ word) * 0x100000001b3ULL;
+	}
+
+	return result;
+}
+
+size_t SolutionCache::entry_size( const std::vector<uint64_t>& key, const Value& value )
+{
+	return sizeof( Entry ) + 4 * sizeof( void * ) + key.size() * sizeof( uint64_t )
+				+ (value.solution.size() + value.prime_implicants.size()) * sizeof( SolutionEntry );
+}
+
+SolutionCache::Entries::iterator SolutionCache::lookup( const std::vector<uint64_t>& key, uint64_t key_hash )
+{
+	auto range = index.equal_range( key_hash );
+
+	for( auto position = range.first; position != range.second; ++position )
+		if( position->second->key == key )
+			return position->second;
+
+	return entries.end();
+}
+
+const SolutionCache::Value * SolutionCache::find( const std::vector<uint64_t>& key )
+{
+	Entries::iterator entry = lookup( key, hash( key ) );
+
+	if( entry == entries.end() ) {
+		++misses;
+		return nullptr;
+	}
+
+	++hits;
+	entries.splice( entries.begin(), entries, entry );
+
+	return &entry->value;
+}
+
+void SolutionCache::insert( const std::vector<uint64_t>& key, const Value& value )
+{
+	uint64_t key_hash = hash( key );
+	size_t needed = entry_size( key, value );
+	Entries::iterator entry = lookup( key, key_hash );
+
+	if( entry != entries.end() ) {
+		size -= entry_size( entry->key, entry->value );
+		entries.splice( entries.begin(), entries, entry );
+		entry->value = value;
+		size += needed;
+		evict( 0 );
+		return;
+	}
+
+	if( needed > capacity )					// would push everything else out, do not bother
+		return;
+
+	evict( needed );
+
+	entries.push_front( Entry { key, key_hash, value } );
+	index.insert( std::make_pair( key_hash, entries.begin() ) );
+	size += needed;
+}
+
+void SolutionCache::evict( size_t needed )
+{
+	while( !entries.empty() && (size + needed > capacity) ) {
+		Entries::iterator oldest = std::prev( entries.end() );
+		auto range = index.equal_range( oldest->hash );
+
+		for( auto position = range.first; position != range.second; ++position )
+			if( position->second == oldest ) {
+				index.erase( position );
+				break;
+			}
+
+		size -= entry_size( oldest->key, oldest->value );
+		entries.erase( oldest );
+		++evictions;
+	}
+}
+
+void SolutionCache::clear()
+{
+	entries.clear();
+	index.clear();
+	size = 0;
+}
+
+void SolutionCache::set_capacity( size_t capacity )
+{
+	this->capacity = capacity;
+
+	evict( 0 );
+}
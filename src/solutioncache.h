@@ -0,0 +1,93 @@
+/*
+ * Copyright 2024 Alwin Leerling <dna.leerling@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#ifndef SOLUTIONCACHE_H
+#define SOLUTIONCACHE_H
+
+#include <vector>
+#include <list>
+#include <unordered_map>
+#include <cstdint>
+#include <cstddef>
+
+#include "solutionentry.h"
+#include "coversolver.h"
+
+/* Least recently used cache of solved tables
+ *
+ * The key is a sequence of words describing the problem completely (the caller packs
+ * the dimension, solution type and the table itself into it), so entries are only
+ * matched on an exact key and a hash collision can never return a wrong solution.
+ * The cache is bounded by an estimate of the bytes its entries take, the least
+ * recently used entries are dropped to stay under it.
+ */
+class SolutionCache
+{
+public:
+	struct Value {
+		SolutionEntries solution;
+		SolutionEntries prime_implicants;
+		CoverStatistics cover_statistics;
+		ReductionStatistics reduction_statistics;
+		bool optimal;							// the solution is proven minimal
+	};
+
+	static const size_t default_capacity = 16 * 1024 * 1024;
+
+	explicit SolutionCache( size_t capacity = default_capacity );
+
+	const Value * find( const std::vector<uint64_t>& key );
+	void insert( const std::vector<uint64_t>& key, const Value& value );
+	void clear();
+
+	void set_capacity( size_t capacity );
+	bool admits_key( size_t words ) const { return sizeof( Entry ) + words * sizeof( uint64_t ) <= capacity; }	// an entry with this key could fit
+	size_t get_capacity() const { return capacity; }
+	size_t get_size() const { return size; }
+	size_t get_entries() const { return entries.size(); }
+
+	unsigned long get_hits() const { return hits; }
+	unsigned long get_misses() const { return misses; }
+	unsigned long get_evictions() const { return evictions; }
+
+private:
+	struct Entry {
+		std::vector<uint64_t> key;
+		uint64_t hash;
+		Value value;
+	};
+
+	typedef std::list<Entry> Entries;
+
+	size_t capacity;
+	size_t size;								// estimated bytes held by the entries
+	Entries entries;							// most recently used first
+	std::unordered_multimap<uint64_t, Entries::iterator> index;
+
+	unsigned long hits;
+	unsigned long misses;
+	unsigned long evictions;
+
+	static uint64_t hash( const std::vector<uint64_t>& key );
+	static size_t entry_size( const std::vector<uint64_t>& key, const Value& value );
+	Entries::iterator lookup( const std::vector<uint64_t>& key, uint64_t key_hash );
+	void evict( size_t needed );
+};
+
+#endif // SOLUTIONCACHE_H
@@ -19,6 +19,8 @@
 
 #include "solutionentry.h"
 
+#include <bitset>
+
 SolutionEntry::SolutionEntry( unsigned int mask, unsigned int number )
 {
 	this->mask = mask;
@@ -54,18 +56,99 @@ bool SolutionEntry::IsDeleted() const
 	return delete_me;
 }
 
+unsigned int SolutionEntry::GetLiteralCount() const
+{
+	return std::bitset<32>( mask ).count();
+}
+
 bool SolutionEntry::operator==( const SolutionEntry& rhs ) const
 {
 	return (mask == rhs.mask) && (number == rhs.number);
 }
 
+/* The variables not in the mask, limited to those below max_address
+ */
+unsigned int SolutionEntry::GetFreeBits( uint64_t max_address ) const
+{
+	uint64_t variables = max_address - 1;
+
+	for( unsigned int shift = 1; shift < 64; shift <<= 1 )
+		variables |= variables >> shift;
+
+	return static_cast<unsigned int>( variables ) & ~mask;
+}
+
+/* Only the addresses in the entry are visited: every subset of the free variables,
+ * in increasing order, added to the number
+ */
 std::vector<unsigned int> SolutionEntry::GetAddresses( unsigned int max_address ) const
 {
 	std::vector<unsigned int> result;
 
-	for( unsigned int address = 0; address < max_address; ++address )
-		if( (address & mask) == number )
-			result.push_back( address );
+	if( (max_address == 0) || (number & ~mask) )
+		return result;
+
+	unsigned int free_bits = GetFreeBits( max_address );
+	unsigned int subset = 0;
+
+	result.reserve( size_t(1) << std::bitset<32>( free_bits ).count() );
+
+	do {
+		if( (number | subset) < max_address )
+			result.push_back( number | subset );
+
+		subset = (subset - free_bits) & free_bits;
+	} while( subset );
 
 	return result;
 }
+
+BitVector SolutionEntry::GetCoverage( const SolutionEntries& entries, uint64_t max_address )
+{
+	BitVector coverage;
+
+	GetCoverage( entries, max_address, coverage );
+
+	return coverage;
+}
+
+void SolutionEntry::GetCoverage( const SolutionEntries& entries, uint64_t max_address, BitVector& coverage )
+{
+	coverage.resize( max_address );
+
+	std::vector<uint64_t>& words = coverage.get_words();
+
+	for( const SolutionEntry& entry : entries ) {
+
+		if( (max_address == 0) || (entry.number & ~entry.mask) )
+			continue;
+
+		/* The free variables below six select cells within a word, the others select words.
+		 * The pattern within a word is the same for every word of the entry.
+		 */
+		unsigned int free_bits = entry.GetFreeBits( max_address );
+		unsigned int word_bits = free_bits >> 6;
+		uint64_t pattern = 0;
+		unsigned int subset = 0;
+
+		do {
+			pattern |= uint64_t(1) << ((entry.number & 63) | subset);
+			subset = (subset - (free_bits & 63)) & free_bits & 63;
+		} while( subset );
+
+		subset = 0;
+		do {
+			size_t index = (entry.number >> 6) | subset;
+
+			if( index < words.size() )
+				words[index] |= pattern;
+
+			subset = (subset - word_bits) & word_bits;
+		} while( subset );
+	}
+
+	/* a max_address that is not a whole number of words leaves cells past the end
+	 */
+	if( max_address & 63 )
+		words.back() &= (uint64_t(1) << (max_address & 63)) - 1;
+}
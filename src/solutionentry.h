@@ -22,6 +22,12 @@
 
 #include <vector>
 
+#include "bitvector.h"
+
+class SolutionEntry;
+
+typedef std::vector<SolutionEntry> SolutionEntries;
+
 class SolutionEntry
 {
 public:
@@ -34,18 +40,25 @@ public:
 
 	unsigned int GetMask() const { return mask; }
 	unsigned int GetNumber() const { return number; }
+	unsigned int GetLiteralCount() const;
 
 	bool MaskEqual( const SolutionEntry& rhs ) const;
 	bool IsDeleted() const;
 	bool operator==( const SolutionEntry& rhs ) const;
 	bool operator!=( const SolutionEntry& rhs ) const { return ! operator==( rhs ); };
 
+	/* The cells covered by any of the entries, in a single pass over the entries.
+	 * The coverage can be written into an existing vector to reuse its storage.
+	 */
+	static BitVector GetCoverage( const SolutionEntries& entries, uint64_t max_address );
+	static void GetCoverage( const SolutionEntries& entries, uint64_t max_address, BitVector& coverage );
+
 private:
 	unsigned int mask;
 	unsigned int number;
 	bool delete_me;
-};
 
-typedef std::vector<SolutionEntry> SolutionEntries;
+	unsigned int GetFreeBits( uint64_t max_address ) const;
+};
 
 #endif // SOLUTIONENTRY_H
@@ -19,6 +19,8 @@
 
 #include "solutiontree.h"
 
+#include "tracer.h"
+
 class SolveTreeItemData : public wxTreeItemData
 {
 public:
@@ -57,6 +59,7 @@ void SolutionTree::RemoveAllItems( bool isSOP, unsigned int solution_size )
 
 void SolutionTree::AddItem( bool isSOP, unsigned int mask, unsigned int number, unsigned long entry_id )
 {
+	TraceSpan span( "SolutionTree::AddItem" );
 	std::string result;
 
 	for( char current_variable_name  = 'a'; mask; ++current_variable_name ) {
@@ -0,0 +1,76 @@
+/*
+ * Copyright 2024 Alwin Leerling <dna.leerling@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#ifndef SOLVELIMIT_H
+#define SOLVELIMIT_H
+
+#include <atomic>
+#include <chrono>
+
+/* Lets a solve be stopped from another thread
+ *
+ * The token can be shared by any number of solves, all of them stop once it is cancelled.
+ * It has to be reset before it can stop anything else.
+ */
+class CancellationToken
+{
+public:
+	CancellationToken() : cancelled( false ) {}
+
+	void cancel() { cancelled.store( true, std::memory_order_relaxed ); }
+	void reset() { cancelled.store( false, std::memory_order_relaxed ); }
+	bool is_cancelled() const { return cancelled.load( std::memory_order_relaxed ); }
+
+private:
+	std::atomic<bool> cancelled;
+};
+
+/* How long a solve may take: a deadline, a cancellation token, both or neither
+ *
+ * The solvers look at it between steps that each leave a valid cover behind, so a solve
+ * that is stopped still returns a correct cover, only not necessarily a minimal one.
+ * Without a deadline no clock is read.
+ */
+class SolveLimit
+{
+public:
+	typedef std::chrono::steady_clock Clock;
+
+	SolveLimit() : deadline( Clock::time_point::max() ), token( nullptr ) {}
+
+	void set_deadline( Clock::time_point new_deadline ) { deadline = new_deadline; }
+	void set_budget( std::chrono::milliseconds budget ) { deadline = Clock::now() + budget; }
+	void set_token( const CancellationToken * new_token ) { token = new_token; }
+
+	bool is_reached() const;
+
+private:
+	Clock::time_point deadline;
+	const CancellationToken * token;
+};
+
+inline bool SolveLimit::is_reached() const
+{
+	if( token && token->is_cancelled() )
+		return true;
+
+	return (deadline != Clock::time_point::max()) && (Clock::now() >= deadline);
+}
+
+#endif // SOLVELIMIT_H
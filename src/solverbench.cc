@@ -0,0 +1,478 @@
+/*
+ * Copyright 2024 Alwin Leerling <dna.leerling@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+/* Benchmarks the solvers on seeded random functions
+ *
+ *	solverbench [-f functions] [-t milliseconds] [-s seed] [-o file]
+ *
+ * Every case is a set of functions of one kind: random ones at a density of ones and
+ * of don't cares, odd parity (where nothing merges) and functions that are mostly don't
+ * cares. Each case runs through find_best_solution in every solver mode and through
+ * the stages on their own: the prime implicants, the cover of those primes, the
+ * heuristic minimiser, the ISOP of the decision diagram, the check of a cover and the
+ * NPN representative the solution cache is keyed on.
+ * The exact methods stop at KarnaughData::exact_input_limit inputs, enumeration at a
+ * few don't cares. Dense random functions of that many inputs have cyclic cores the
+ * exact search takes seconds to minutes on, random functions are solved exactly up to
+ * one input less.
+ *
+ * A benchmark repeats its functions for at least the given time and reports the time
+ * per solve, the prime implicants generated (none for the heuristic minimiser and the
+ * ISOP) and the terms in the result. A last pass counts the heap allocations of every
+ * solve and the most heap in use at once on top of what was in use before it. That pass
+ * comes after the timed runs, buffers the solvers keep are already grown and not counted.
+ * The exact solves through KarnaughData keep everything in their workspaces and count
+ * none.
+ *
+ * The results go as JSON to standard output, or to the file given with -o, so runs of
+ * different versions can be compared.
+ */
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+#include <functional>
+#include <algorithm>
+#include <new>
+#include <cstdlib>
+#include <cstddef>
+
+#include "karnaughdata.h"
+#include "truthtable.h"
+#include "fixedquinemccluskey.h"
+#include "primechart.h"
+#include "coversolver.h"
+#include "espresso.h"
+#include "bddmanager.h"
+#include "coververifier.h"
+#include "npncanonizer.h"
+
+/* Every allocation through the global operator new is counted, along with the bytes in
+ * use. The size is kept in front of the block for operator delete. The solvers run on
+ * the calling thread only, so plain counters do.
+ */
+namespace
+{
+	struct HeapCounters
+	{
+		size_t in_use;
+		size_t peak;
+		unsigned long allocations;
+	};
+
+	HeapCounters heap = { 0, 0, 0 };
+
+	const size_t header_size = alignof( std::max_align_t );
+}
+
+void * operator new( size_t size )
+{
+	char * block = static_cast<char *>( std::malloc( size + header_size ) );
+
+	if( !block )
+		throw std::bad_alloc();
+
+	*reinterpret_cast<size_t *>( block ) = size;
+
+	heap.in_use += size;
+	heap.peak = std::max( heap.peak, heap.in_use );
+	++heap.allocations;
+
+	return block + header_size;
+}
+
+void operator delete( void * pointer ) noexcept
+{
+	if( !pointer )
+		return;
+
+	char * block = static_cast<char *>( pointer ) - header_size;
+
+	heap.in_use -= *reinterpret_cast<size_t *>( block );
+	std::free( block );
+}
+
+void * operator new[]( size_t size ) { return operator new( size ); }
+void operator delete[]( void * pointer ) noexcept { operator delete( pointer ); }
+void operator delete( void * pointer, size_t ) noexcept { operator delete( pointer ); }
+void operator delete[]( void * pointer, size_t ) noexcept { operator delete( pointer ); }
+
+namespace
+{
+	const unsigned int enumerate_dontcare_limit = 6;		// 2^n scenarios per function
+
+	enum eKind { RANDOM, PARITY, MANY_DONTCARES };
+
+	struct Case
+	{
+		eKind kind;
+		unsigned int no_of_inputs;
+		unsigned int ones;				// percentage of the cells
+		unsigned int dontcares;
+	};
+
+	/* One function of a case with everything the stages take as input, prepared up front
+	 * so the timings only hold the stage itself
+	 */
+	struct Function
+	{
+		TruthTable table;
+		std::vector<unsigned int> minterms;
+		std::vector<unsigned int> dontcares;
+		std::vector<unsigned int> care_set;		// minterms and don't cares, what the primes are made of
+		SolutionEntries primes;
+		SolutionEntries on_set;
+		SolutionEntries dc_set;
+		SolutionEntries off_set;
+		BitVector lower;
+		BitVector upper;
+	};
+
+	struct Result
+	{
+		double ns_per_solve;
+		double implicants;				// averages over the functions
+		double terms;
+		double allocations;
+		size_t peak_bytes;				// largest over the functions
+	};
+
+	/* Returns the number of implicants generated and the number of terms in the result
+	 */
+	typedef std::function<void( const Function&, unsigned long&, unsigned long& )> Solve;
+
+	const char * kind_name( eKind kind )
+	{
+		switch( kind ) {
+		case PARITY: return "parity";
+		case MANY_DONTCARES: return "many_dontcares";
+		default: return "random";
+		}
+	}
+
+	Function make_function( const Case& bench_case, std::mt19937& generator )
+	{
+		std::uniform_int_distribution<unsigned int> percentage( 0, 99 );
+		unsigned int variables = (1u << bench_case.no_of_inputs) - 1;
+		Function function;
+
+		function.table.resize( bench_case.no_of_inputs );
+
+		for( unsigned int address = 0; address <= variables; ++address ) {
+			if( bench_case.kind == PARITY ) {
+				if( __builtin_popcount( address ) & 1 )
+					function.table.set_one( address );
+				continue;
+			}
+
+			unsigned int draw = percentage( generator );
+
+			if( draw < bench_case.ones )
+				function.table.set_one( address );
+			else if( draw < bench_case.ones + bench_case.dontcares )
+				function.table.set_dontcare( address );
+		}
+
+		for( unsigned int address = 0; address <= variables; ++address ) {
+			SolutionEntry cube( variables, address );
+
+			if( function.table.is_one( address ) ) {
+				function.minterms.push_back( address );
+				function.on_set.push_back( cube );
+			} else if( function.table.is_dontcare( address ) ) {
+				function.dontcares.push_back( address );
+				function.dc_set.push_back( cube );
+			} else
+				function.off_set.push_back( cube );
+		}
+
+		function.care_set = function.minterms;
+		function.care_set.insert( function.care_set.end(), function.dontcares.begin(), function.dontcares.end() );
+		std::sort( function.care_set.begin(), function.care_set.end() );
+
+		if( bench_case.no_of_inputs <= KarnaughData::exact_input_limit )
+			find_fixed_prime_implicants( bench_case.no_of_inputs, function.care_set, function.primes );
+
+		function.lower = function.table.get_on_set();
+		function.upper = function.table.get_on_set();
+		function.upper |= function.table.get_dc_set();
+
+		return function;
+	}
+
+	Result run( const std::vector<Function>& functions, unsigned int min_milliseconds, const Solve& solve )
+	{
+		Result result = { 0, 0, 0, 0, 0 };
+		unsigned long implicants;
+		unsigned long terms;
+		unsigned long solves = 0;
+
+		auto start = std::chrono::steady_clock::now();
+		std::chrono::duration<double, std::nano> elapsed;
+
+		do {
+			for( const Function& function : functions )
+				solve( function, implicants, terms );
+
+			solves += functions.size();
+			elapsed = std::chrono::steady_clock::now() - start;
+		} while( elapsed < std::chrono::milliseconds( min_milliseconds ) );
+
+		result.ns_per_solve = elapsed.count() / solves;
+
+		for( const Function& function : functions ) {
+			size_t base = heap.in_use;
+			unsigned long allocations = heap.allocations;
+
+			heap.peak = base;
+			solve( function, implicants, terms );
+
+			result.implicants += implicants;
+			result.terms += terms;
+			result.allocations += heap.allocations - allocations;
+			result.peak_bytes = std::max( result.peak_bytes, heap.peak - base );
+		}
+
+		result.implicants /= functions.size();
+		result.terms /= functions.size();
+		result.allocations /= functions.size();
+
+		return result;
+	}
+
+	std::vector<Case> make_cases()
+	{
+		const unsigned int input_counts[] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+		const unsigned int one_densities[] = { 25, 50, 75 };
+		const unsigned int dontcare_densities[] = { 0, 10, 30 };
+		std::vector<Case> cases;
+
+		for( unsigned int no_of_inputs : input_counts ) {
+			for( unsigned int ones : one_densities )
+				for( unsigned int dontcares : dontcare_densities )
+					if( ones + dontcares < 100 )
+						cases.push_back( Case { RANDOM, no_of_inputs, ones, dontcares } );
+
+			cases.push_back( Case { PARITY, no_of_inputs, 50, 0 } );
+			cases.push_back( Case { MANY_DONTCARES, no_of_inputs, 10, 80 } );
+		}
+
+		return cases;
+	}
+
+	void write_result( std::ostream& out, bool& first, const Case& bench_case, const std::string& stage, const Result& result )
+	{
+		out << (first ? "\n" : ",\n");
+		first = false;
+
+		out << "\t\t{ \"name\": \"" << stage << '/' << kind_name( bench_case.kind ) << '/' << bench_case.no_of_inputs
+			<< '/' << bench_case.ones << '/' << bench_case.dontcares << "\", "
+			<< "\"stage\": \"" << stage << "\", "
+			<< "\"kind\": \"" << kind_name( bench_case.kind ) << "\", "
+			<< "\"inputs\": " << bench_case.no_of_inputs << ", "
+			<< "\"ones_percent\": " << bench_case.ones << ", "
+			<< "\"dontcares_percent\": " << bench_case.dontcares << ", "
+			<< "\"ns_per_solve\": " << result.ns_per_solve << ", "
+			<< "\"implicants\": " << result.implicants << ", "
+			<< "\"terms\": " << result.terms << ", "
+			<< "\"allocations\": " << result.allocations << ", "
+			<< "\"peak_bytes\": " << result.peak_bytes << " }";
+	}
+
+	void usage()
+	{
+		std::cerr << "usage: solverbench [-f functions] [-t milliseconds] [-s seed] [-o file]\n";
+	}
+}
+
+int main( int argc, char * argv[] )
+{
+	unsigned int no_of_functions = 10;
+	unsigned int min_milliseconds = 20;
+	unsigned int seed = 1;
+	std::string file_name;
+
+	for( int index = 1; index < argc; ++index ) {
+		std::string argument = argv[index];
+
+		if( (argument == "-f") && (index + 1 < argc) )
+			no_of_functions = std::strtoul( argv[++index], nullptr, 10 );
+		else if( (argument == "-t") && (index + 1 < argc) )
+			min_milliseconds = std::strtoul( argv[++index], nullptr, 10 );
+		else if( (argument == "-s") && (index + 1 < argc) )
+			seed = std::strtoul( argv[++index], nullptr, 10 );
+		else if( (argument == "-o") && (index + 1 < argc) )
+			file_name = argv[++index];
+		else {
+			usage();
+			return 2;
+		}
+	}
+
+	if( no_of_functions == 0 ) {
+		usage();
+		return 2;
+	}
+
+	const std::pair<KarnaughData::eSolverMode, const char *> modes[] = {
+		{ KarnaughData::TABULAR, "solve_tabular" },
+		{ KarnaughData::ENUMERATE, "solve_enumerate" },
+		{ KarnaughData::HEURISTIC, "solve_heuristic" },
+		{ KarnaughData::ISOP, "solve_isop" }
+	};
+
+	std::mt19937 generator( seed );
+	std::ostringstream out;
+	bool first = true;
+
+	out << "{\n\t\"seed\": " << seed << ",\n\t\"functions\": " << no_of_functions
+		<< ",\n\t\"min_milliseconds\": " << min_milliseconds << ",\n\t\"benchmarks\": [";
+
+	for( const Case& bench_case : make_cases() ) {
+		std::vector<Function> functions;
+		unsigned int exact_limit = (bench_case.kind == RANDOM) ? KarnaughData::exact_input_limit - 1 : KarnaughData::exact_input_limit;
+		bool exact = bench_case.no_of_inputs <= exact_limit;
+		size_t most_dontcares = 0;
+
+		for( unsigned int count = 0; count < no_of_functions; ++count ) {
+			functions.push_back( make_function( bench_case, generator ) );
+			most_dontcares = std::max( most_dontcares, functions.back().dontcares.size() );
+		}
+
+		std::cerr << "solverbench: " << kind_name( bench_case.kind ) << ' ' << bench_case.no_of_inputs << " inputs "
+					<< bench_case.ones << "% ones " << bench_case.dontcares << "% don't cares\n";
+
+		for( const auto& mode : modes ) {
+			if( !exact && ((mode.first == KarnaughData::TABULAR) || (mode.first == KarnaughData::ENUMERATE)) )
+				continue;
+
+			if( (mode.first == KarnaughData::ENUMERATE) && (most_dontcares > enumerate_dontcare_limit) )
+				continue;
+
+			/* Without the cache every repeat would be a lookup, one thread keeps the
+			 * allocation counts to this thread
+			 */
+			KarnaughData data;
+
+			data.set_cache_capacity( 0 );
+			data.set_thread_count( 1 );
+			data.set_dimension( bench_case.no_of_inputs );
+			data.set_solver_mode( mode.first );
+
+			Result result = run( functions, min_milliseconds, [&data]( const Function& function, unsigned long& implicants, unsigned long& terms ) {
+				data.set_table( function.table );
+				terms = data.find_best_solution().size();
+				implicants = data.get_prime_implicants().size();
+			} );
+
+			write_result( out, first, bench_case, mode.second, result );
+		}
+
+		if( exact ) {
+			unsigned int no_of_inputs = bench_case.no_of_inputs;
+
+			Result primes = run( functions, min_milliseconds, [no_of_inputs]( const Function& function, unsigned long& implicants, unsigned long& terms ) {
+				SolutionEntries result;
+
+				find_fixed_prime_implicants( no_of_inputs, function.care_set, result );
+				implicants = result.size();
+				terms = 0;
+			} );
+
+			write_result( out, first, bench_case, "prime_implicants", primes );
+
+			Result cover = run( functions, min_milliseconds, []( const Function& function, unsigned long& implicants, unsigned long& terms ) {
+				PrimeChart chart( function.primes, function.minterms );
+				CoverSolver solver( chart );
+
+				chart.reduce();
+				implicants = function.primes.size();
+				terms = function.minterms.empty() ? 0 : solver.solve().size();
+			} );
+
+			write_result( out, first, bench_case, "select_cover", cover );
+		}
+
+		Result heuristic = run( functions, min_milliseconds, [&bench_case]( const Function& function, unsigned long& implicants, unsigned long& terms ) {
+			Espresso engine( bench_case.no_of_inputs );
+
+			terms = engine.minimise( function.on_set, function.dc_set, function.off_set ).size();
+			implicants = 0;
+		} );
+
+		write_result( out, first, bench_case, "espresso", heuristic );
+
+		Result isop = run( functions, min_milliseconds, [&bench_case]( const Function& function, unsigned long& implicants, unsigned long& terms ) {
+			BddManager bdd( bench_case.no_of_inputs );
+
+			terms = bdd.isop( bdd.from_cells( function.lower ), bdd.from_cells( function.upper ) ).size();
+			implicants = 0;
+		} );
+
+		write_result( out, first, bench_case, "bdd_isop", isop );
+
+		/* The ON-set cubes are a correct cover with as many terms as there are ones
+		 */
+		CoverVerifier verifier;
+
+		Result verify = run( functions, min_milliseconds, [&verifier]( const Function& function, unsigned long& implicants, unsigned long& terms ) {
+			verifier.verify( function.on_set, function.table, false );
+			implicants = 0;
+			terms = function.on_set.size();
+		} );
+
+		write_result( out, first, bench_case, "verify_cover", verify );
+
+		/* to be set against the time of a solve, which a cache miss adds it to
+		 */
+		Result canonize = run( functions, min_milliseconds, [&bench_case]( const Function& function, unsigned long& implicants, unsigned long& terms ) {
+			NpnCanonizer canonizer( bench_case.no_of_inputs );
+			BitVector canonical_target;
+			BitVector canonical_dontcare;
+
+			canonizer.canonize( function.table.get_on_set(), function.table.get_dc_set(), canonical_target, canonical_dontcare );
+			implicants = 0;
+			terms = 0;
+		} );
+
+		write_result( out, first, bench_case, "npn_canonize", canonize );
+	}
+
+	out << "\n\t]\n}\n";
+
+	if( file_name.empty() ) {
+		std::cout << out.str();
+		return 0;
+	}
+
+	std::ofstream file( file_name );
+
+	file << out.str();
+
+	if( !file ) {
+		std::cerr << "solverbench: cannot write " << file_name << '\n';
+		return 1;
+	}
+
+	return 0;
+}
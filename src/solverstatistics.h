@@ -0,0 +1,110 @@
+/*
+ * Copyright 2024 Alwin Leerling <dna.leerling@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#ifndef SOLVERSTATISTICS_H
+#define SOLVERSTATISTICS_H
+
+#include <chrono>
+
+#include "tracer.h"
+
+/* What a solve did and where its time went
+ *
+ * KarnaughData::find_best_solution fills it when collecting is on. The tabulation counts
+ * the implicants it made by merging, the cover search counts its nodes. Every phase is
+ * timed on its own.
+ * Phases of tasks running side by side (the don't care scenarios) add up their times,
+ * together they can take longer than the whole solve.
+ *
+ * Collecting is switched on per KarnaughData. Off, and not tracing, no clock is read and
+ * nothing is added.
+ */
+struct SolverStatistics
+{
+	enum ePhase { TABULATION, COVER, HEURISTIC, ISOP, VERIFICATION, no_of_phases };
+
+	bool from_cache;					// the solution came out of the cache, nothing was solved
+	unsigned long scenarios;			// don't care assignments solved
+	unsigned long merges;				// implicants with one or more free variables
+	unsigned long prime_implicants;
+	unsigned long search_nodes;			// nodes visited by the cover search
+	double phase_milliseconds[no_of_phases];
+	double total_milliseconds;
+
+	void clear() { *this = SolverStatistics(); }
+	void add( const SolverStatistics& rhs );
+
+	static const char * get_phase_name( ePhase phase );
+};
+
+inline void SolverStatistics::add( const SolverStatistics& rhs )
+{
+	scenarios += rhs.scenarios;
+	merges += rhs.merges;
+	prime_implicants += rhs.prime_implicants;
+	search_nodes += rhs.search_nodes;
+
+	for( unsigned int phase = 0; phase < no_of_phases; ++phase )
+		phase_milliseconds[phase] += rhs.phase_milliseconds[phase];
+}
+
+inline const char * SolverStatistics::get_phase_name( ePhase phase )
+{
+	static const char * const names[no_of_phases] = { "tabulation", "cover", "heuristic", "isop", "verification" };
+
+	return names[phase];
+}
+
+/* Adds the time between its construction and destruction to a phase, given statistics
+ * to add it to, and records it as a span of the phase while tracing
+ */
+class PhaseTimer
+{
+public:
+	PhaseTimer( SolverStatistics * statistics, SolverStatistics::ePhase phase ) : statistics( statistics ), phase( phase ), traced( Tracer::is_enabled() )
+	{
+		if( statistics || traced )
+			start = std::chrono::steady_clock::now();
+	}
+
+	~PhaseTimer()
+	{
+		if( !statistics && !traced )
+			return;
+
+		std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+		if( statistics )
+			statistics->phase_milliseconds[phase] += std::chrono::duration<double, std::milli>( end - start ).count();
+
+		if( traced )
+			Tracer::record( SolverStatistics::get_phase_name( phase ), start, end );
+	}
+
+	PhaseTimer( const PhaseTimer& ) = delete;
+	PhaseTimer& operator=( const PhaseTimer& ) = delete;
+
+private:
+	SolverStatistics * statistics;
+	SolverStatistics::ePhase phase;
+	bool traced;
+	std::chrono::steady_clock::time_point start;
+};
+
+#endif // SOLVERSTATISTICS_H
@@ -0,0 +1,44 @@
+/*
+ * Copyright 2024 Alwin Leerling <dna.leerling@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#include "solverworkspace.h"
+
+SolverWorkspace::SolverWorkspace()
+{
+	current.scenario = -1;
+	best.scenario = -1;
+	statistics.clear();
+}
+
+/* The chart and the search buffers are overwritten by the next solve, they are left as
+ * they are
+ */
+void SolverWorkspace::reset()
+{
+	minterms.clear();
+	dontcares.clear();
+	addresses.clear();
+	current.scenario = -1;
+	current.solution.clear();
+	current.primes.clear();
+	best.scenario = -1;
+	best.solution.clear();
+	best.primes.clear();
+	statistics.clear();
+}
@@ -0,0 +1,69 @@
+/*
+ * Copyright 2024 Alwin Leerling <dna.leerling@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#ifndef SOLVERWORKSPACE_H
+#define SOLVERWORKSPACE_H
+
+#include <vector>
+#include <cstddef>
+
+#include "solutionentry.h"
+#include "primechart.h"
+#include "coversolver.h"
+#include "solverstatistics.h"
+
+/* Buffers reused from one solve to the next
+ *
+ * The solver fills these instead of creating its temporaries: the addresses, the
+ * candidate covers, the prime chart and the memory of the cover search. reset() empties
+ * them all but keeps their memory. Once they have grown to the size of the problems
+ * being solved a solve on one thread does not allocate anymore, allocationtest counts
+ * the calls to operator new to hold it to that.
+ *
+ * One workspace serves one thread, the enumerating solver keeps one per task.
+ */
+class SolverWorkspace
+{
+public:
+	/* a don't care scenario, or the best one seen so far
+	 */
+	struct Candidate {
+		int scenario;
+		unsigned int literals;
+		SolutionEntries solution;
+		SolutionEntries primes;
+		CoverStatistics cover;
+		ReductionStatistics reduction;
+	};
+
+	SolverWorkspace();
+
+	void reset();
+
+	std::vector<unsigned int> minterms;
+	std::vector<unsigned int> dontcares;
+	std::vector<unsigned int> addresses;
+	Candidate current;
+	Candidate best;
+	SolverStatistics statistics;		// of the task using the workspace
+	PrimeChart chart;
+	SearchBuffers search;
+};
+
+#endif // SOLVERWORKSPACE_H
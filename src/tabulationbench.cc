@@ -0,0 +1,111 @@
+/*
+ * Copyright 2024 Alwin Leerling <dna.leerling@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+/* Compares the generic tabulation with the one instantiated per number of inputs
+ *
+ * For every table size from 1 to 8 inputs a set of seeded random functions is run
+ * through both, at a few densities of the function. Prints the time per call of each
+ * and checks they return the same primes.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include "quinemccluskey.h"
+#include "fixedquinemccluskey.h"
+
+typedef std::vector<std::vector<unsigned int>> Functions;
+
+static Functions make_functions( unsigned int no_of_inputs, unsigned int density, unsigned int count, std::mt19937& generator )
+{
+	Functions functions( count );
+	std::uniform_int_distribution<unsigned int> percentage( 0, 99 );
+
+	for( std::vector<unsigned int>& addresses : functions )
+		for( unsigned int address = 0; address < (1u << no_of_inputs); ++address )
+			if( percentage( generator ) < density )
+				addresses.push_back( address );
+
+	return functions;
+}
+
+template<typename Solve>
+static double time_per_call( const Functions& functions, unsigned int repeats, Solve solve )
+{
+	auto start = std::chrono::steady_clock::now();
+
+	for( unsigned int repeat = 0; repeat < repeats; ++repeat )
+		for( const std::vector<unsigned int>& addresses : functions )
+			solve( addresses );
+
+	std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+
+	return elapsed.count() / (double( repeats ) * functions.size());
+}
+
+int main( int argc, char * argv[] )
+{
+	unsigned int repeats = (argc > 1) ? std::atoi( argv[1] ) : 20;
+	const unsigned int densities[] = { 25, 50, 75 };
+	const unsigned int count = 200;
+	std::mt19937 generator( 1 );
+	bool all_equal = true;
+
+	std::printf( "inputs density    generic ns    fixed ns  speedup\n" );
+
+	for( unsigned int no_of_inputs = 1; no_of_inputs <= 8; ++no_of_inputs ) {
+		for( unsigned int density : densities ) {
+			Functions functions = make_functions( no_of_inputs, density, count, generator );
+			SolutionEntries generic_primes;
+			SolutionEntries fixed_primes;
+
+			for( const std::vector<unsigned int>& addresses : functions ) {
+				QuineMcCluskey engine( no_of_inputs );
+
+				generic_primes = engine.find_prime_implicants( addresses );
+				find_fixed_prime_implicants( no_of_inputs, addresses, fixed_primes );
+
+				if( generic_primes != fixed_primes )
+					all_equal = false;
+			}
+
+			double generic_time = time_per_call( functions, repeats, [&]( const std::vector<unsigned int>& addresses ) {
+				QuineMcCluskey engine( no_of_inputs );
+
+				generic_primes = engine.find_prime_implicants( addresses );
+			} );
+
+			double fixed_time = time_per_call( functions, repeats, [&]( const std::vector<unsigned int>& addresses ) {
+				find_fixed_prime_implicants( no_of_inputs, addresses, fixed_primes );
+			} );
+
+			std::printf( "%6u %6u%% %13.0f %11.0f %7.1fx\n", no_of_inputs, density, generic_time, fixed_time, generic_time / fixed_time );
+		}
+	}
+
+	if( !all_equal ) {
+		std::printf( "the two tabulations returned different primes\n" );
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,100 @@
+/*
+ * Copyright 2024 Alwin Leerling <dna.leerling@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#include "threadpool.h"
+
+ThreadPool::ThreadPool( unsigned int thread_count )
+{
+	this->thread_count = thread_count ? thread_count : default_thread_count();
+	pending = 0;
+	stopping = false;
+
+	if( this->thread_count > 1 )
+		for( unsigned int index = 0; index < this->thread_count; ++index )
+			workers.emplace_back( &ThreadPool::run, this );
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock( mutex );
+		stopping = true;
+	}
+
+	task_available.notify_all();
+
+	for( std::thread& worker : workers )
+		worker.join();
+}
+
+unsigned int ThreadPool::default_thread_count()
+{
+	unsigned int count = std::thread::hardware_concurrency();
+
+	return count ? count : 1;
+}
+
+void ThreadPool::submit( std::function<void()> task )
+{
+	if( workers.empty() ) {
+		task();
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock( mutex );
+		tasks.push_back( std::move( task ) );
+		++pending;
+	}
+
+	task_available.notify_one();
+}
+
+void ThreadPool::wait()
+{
+	std::unique_lock<std::mutex> lock( mutex );
+
+	tasks_done.wait( lock, [this]() { return pending == 0; } );
+}
+
+void ThreadPool::run()
+{
+	for( ;; ) {
+		std::function<void()> task;
+
+		{
+			std::unique_lock<std::mutex> lock( mutex );
+
+			task_available.wait( lock, [this]() { return stopping || !tasks.empty(); } );
+
+			if( tasks.empty() )
+				return;
+
+			task = std::move( tasks.front() );
+			tasks.pop_front();
+		}
+
+		task();
+
+		std::lock_guard<std::mutex> lock( mutex );
+
+		if( --pending == 0 )
+			tasks_done.notify_all();
+	}
+}
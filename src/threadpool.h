@@ -0,0 +1,62 @@
+/*
+ * Copyright 2024 Alwin Leerling <dna.leerling@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+/* Fixed set of worker threads running queued tasks
+ *
+ * A pool of one thread runs every task directly in submit, so single threaded solving
+ * takes the same path as the parallel one without any locking or thread switches.
+ * Tasks must not wait on other tasks of the same pool.
+ */
+class ThreadPool
+{
+public:
+	explicit ThreadPool( unsigned int thread_count = 0 );
+	~ThreadPool();
+
+	void submit( std::function<void()> task );
+	void wait();
+
+	unsigned int get_thread_count() const { return thread_count; }
+
+	static unsigned int default_thread_count();
+
+private:
+	unsigned int thread_count;
+	std::vector<std::thread> workers;
+	std::deque<std::function<void()>> tasks;
+	std::mutex mutex;
+	std::condition_variable task_available;
+	std::condition_variable tasks_done;
+	unsigned int pending;					// tasks queued or running
+	bool stopping;
+
+	void run();
+};
+
+#endif // THREADPOOL_H
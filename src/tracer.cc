@@ -0,0 +1,133 @@
+/*
+ * Copyright 2024 Alwin Leerling <dna.leerling@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#include "tracer.h"
+
+#include <algorithm>
+#include <fstream>
+#include <cstdio>
+
+std::atomic<bool> Tracer::enabled( false );
+const Tracer::Clock::time_point Tracer::epoch = Tracer::Clock::now();
+std::mutex Tracer::buffers_mutex;
+std::vector<std::unique_ptr<Tracer::Buffer>> Tracer::buffers;
+
+const size_t Tracer::buffer_size;
+
+/* The buffers stay with the tracer when their thread ends, a pool that has been shut
+ * down still shows up in the trace
+ */
+Tracer::Buffer& Tracer::thread_buffer()
+{
+	thread_local Buffer * buffer = nullptr;
+
+	if( !buffer ) {
+		std::lock_guard<std::mutex> lock( buffers_mutex );
+
+		buffers.emplace_back( new Buffer );
+		buffer = buffers.back().get();
+		buffer->thread_id = buffers.size();
+		buffer->head = 0;
+		buffer->first = 0;
+		buffer->slots.reset( new Slot[buffer_size] );
+	}
+
+	return *buffer;
+}
+
+void Tracer::record( const char * name, Clock::time_point start, Clock::time_point end )
+{
+	Buffer& buffer = thread_buffer();
+	uint64_t head = buffer.head.load( std::memory_order_relaxed );
+	Slot& slot = buffer.slots[head % buffer_size];
+
+	/* The fence orders the head published by the previous event before the stores into
+	 * the slot: a write() that reads any of them then also sees head at least this far
+	 */
+	std::atomic_thread_fence( std::memory_order_release );
+
+	slot.name.store( name, std::memory_order_relaxed );
+	slot.start.store( std::chrono::duration_cast<std::chrono::nanoseconds>( start - epoch ).count(), std::memory_order_relaxed );
+	slot.duration.store( std::chrono::duration_cast<std::chrono::nanoseconds>( end - start ).count(), std::memory_order_relaxed );
+
+	buffer.head.store( head + 1, std::memory_order_release );
+}
+
+void Tracer::clear()
+{
+	std::lock_guard<std::mutex> lock( buffers_mutex );
+
+	for( std::unique_ptr<Buffer>& buffer : buffers )
+		buffer->first.store( buffer->head.load( std::memory_order_acquire ), std::memory_order_relaxed );
+}
+
+bool Tracer::write( std::ostream& out )
+{
+	std::lock_guard<std::mutex> lock( buffers_mutex );
+	std::vector<Event> events;
+	bool first_event = true;
+	char line[64];
+
+	out << "{\"traceEvents\":[";
+
+	for( std::unique_ptr<Buffer>& buffer : buffers ) {
+
+		/* Copy what is in the buffer, then drop whatever the thread overwrote while it
+		 * was being copied. The thread writes event h into its slot before it publishes
+		 * head h + 1, so with head at overwritten the event overwritten - buffer_size may
+		 * be half written, and every event before it is gone
+		 */
+		uint64_t head = buffer->head.load( std::memory_order_acquire );
+		uint64_t begin = std::max( buffer->first.load( std::memory_order_relaxed ), (head > buffer_size) ? head - buffer_size : 0 );
+
+		events.clear();
+		for( uint64_t index = begin; index < head; ++index ) {
+			const Slot& slot = buffer->slots[index % buffer_size];
+
+			events.push_back( Event{ slot.name.load( std::memory_order_relaxed ), slot.start.load( std::memory_order_relaxed ), slot.duration.load( std::memory_order_relaxed ) } );
+		}
+
+		std::atomic_thread_fence( std::memory_order_acquire );
+
+		uint64_t overwritten = buffer->head.load( std::memory_order_relaxed );
+		size_t skip = (overwritten >= begin + buffer_size) ? std::min<uint64_t>( overwritten - begin - buffer_size + 1, events.size() ) : 0;
+
+		for( size_t index = skip; index < events.size(); ++index ) {
+			const Event& event = events[index];
+
+			std::snprintf( line, sizeof( line ), "%.3f,\"dur\":%.3f", event.start / 1000.0, event.duration / 1000.0 );
+
+			out << (first_event ? "\n" : ",\n") << "{\"name\":\"" << event.name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->thread_id
+				<< ",\"ts\":" << line << "}";
+
+			first_event = false;
+		}
+	}
+
+	out << "\n]}\n";
+
+	return bool( out );
+}
+
+bool Tracer::write( const std::string& file_name )
+{
+	std::ofstream file( file_name );
+
+	return file && write( file );
+}
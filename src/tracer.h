@@ -0,0 +1,120 @@
+/*
+ * Copyright 2024 Alwin Leerling <dna.leerling@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#ifndef TRACER_H
+#define TRACER_H
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+/* Records spans of time and writes them as Chrome trace events
+ *
+ * A span is a TraceSpan on the stack, it records its name and the time from its
+ * construction to its destruction. Every thread records into a ring buffer of its own,
+ * claimed the first time it records, so recording takes no lock. A full buffer overwrites
+ * its oldest events, and as the slot of the next event may be in use the last
+ * buffer_size - 1 events of a thread are written.
+ *
+ * write() puts the events of every thread out as complete events ("ph": "X") of the
+ * trace event format that chrome://tracing and Perfetto read. Threads may go on
+ * recording meanwhile, the buffers are then read like a seqlock: every event the thread
+ * may have started to overwrite during the copy is left out.
+ *
+ * Tracing is off until set_enabled( true ), a span then costs one atomic load. The names
+ * are not copied, they have to be string literals.
+ */
+class Tracer
+{
+public:
+	typedef std::chrono::steady_clock Clock;
+
+	static const size_t buffer_size = 1 << 16;				// events kept per thread
+
+	static void set_enabled( bool on ) { enabled.store( on, std::memory_order_relaxed ); }
+	static bool is_enabled() { return enabled.load( std::memory_order_relaxed ); }
+
+	static void record( const char * name, Clock::time_point start, Clock::time_point end );
+	static void clear();
+
+	static bool write( std::ostream& out );
+	static bool write( const std::string& file_name );
+
+private:
+	struct Event {
+		const char * name;
+		int64_t start;				// nanoseconds since the tracer started
+		int64_t duration;
+	};
+
+	/* An event as it is kept in a buffer, write() may read a slot while its thread
+	 * overwrites it so the fields are atomics, used relaxed
+	 */
+	struct Slot {
+		std::atomic<const char *> name;
+		std::atomic<int64_t> start;
+		std::atomic<int64_t> duration;
+	};
+
+	/* Only the owning thread writes events and moves head, first is moved by clear()
+	 */
+	struct Buffer {
+		unsigned int thread_id;
+		std::atomic<uint64_t> head;			// events recorded since the buffer was claimed
+		std::atomic<uint64_t> first;		// the oldest one still wanted
+		std::unique_ptr<Slot[]> slots;
+	};
+
+	static std::atomic<bool> enabled;
+	static const Clock::time_point epoch;
+	static std::mutex buffers_mutex;
+	static std::vector<std::unique_ptr<Buffer>> buffers;
+
+	static Buffer& thread_buffer();
+};
+
+class TraceSpan
+{
+public:
+	explicit TraceSpan( const char * name ) : name( Tracer::is_enabled() ? name : nullptr )
+	{
+		if( this->name )
+			start = Tracer::Clock::now();
+	}
+
+	~TraceSpan()
+	{
+		if( name )
+			Tracer::record( name, start, Tracer::Clock::now() );
+	}
+
+	TraceSpan( const TraceSpan& ) = delete;
+	TraceSpan& operator=( const TraceSpan& ) = delete;
+
+private:
+	const char * name;
+	Tracer::Clock::time_point start;
+};
+
+#endif // TRACER_H
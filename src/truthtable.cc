@@ -0,0 +1,81 @@
+/*
+ * Copyright 2024 Alwin Leerling <dna.leerling@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#include "truthtable.h"
+
+TruthTable::TruthTable()
+{
+	resize( 0 );
+}
+
+void TruthTable::resize( unsigned int no_of_inputs )
+{
+	if( no_of_inputs > max_inputs )
+		no_of_inputs = max_inputs;
+
+	this->no_of_inputs = no_of_inputs;
+
+	on_set.resize( size() );
+	dc_set.resize( size() );
+}
+
+void TruthTable::clear()
+{
+	on_set.clear();
+	dc_set.clear();
+}
+
+void TruthTable::set_one( uint64_t address )
+{
+	on_set.set( address );
+	dc_set.reset( address );
+}
+
+void TruthTable::set_zero( uint64_t address )
+{
+	on_set.reset( address );
+	dc_set.reset( address );
+}
+
+void TruthTable::set_dontcare( uint64_t address )
+{
+	on_set.reset( address );
+	dc_set.set( address );
+}
+
+/* Whole sets at once, both of size() cells. A cell in both sets is a one.
+ */
+void TruthTable::assign( const BitVector& ones, const BitVector& dontcares )
+{
+	on_set = ones;
+	dc_set = dontcares;
+	dc_set.remove( ones );
+}
+
+uint64_t TruthTable::get_zero_word( size_t index ) const
+{
+	uint64_t word = ~(on_set.get_words()[index] | dc_set.get_words()[index]);
+
+	/* A table smaller than a word only uses the low bits of it
+	 */
+	if( size() < 64 )
+		word &= (uint64_t(1) << size()) - 1;
+
+	return word;
+}
@@ -0,0 +1,74 @@
+/*
+ * Copyright 2024 Alwin Leerling <dna.leerling@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#ifndef TRUTHTABLE_H
+#define TRUTHTABLE_H
+
+#include <cstdint>
+
+#include "bitvector.h"
+
+/* Bit packed storage of a single output truth table
+ *
+ * Every cell takes two bits: one in the ON-set and one in the don't care set. A cell is
+ * never in both, a cell in neither is a zero. Both sets are stored as 64 bit words so
+ * whole table operations (clearing, counting) run a word at a time. The table holds up
+ * to 2^32 cells.
+ */
+class TruthTable
+{
+public:
+	static const unsigned int max_inputs = 32;
+
+	TruthTable();
+
+	void resize( unsigned int no_of_inputs );
+	void clear();
+
+	uint64_t size() const { return uint64_t(1) << no_of_inputs; }
+	unsigned int get_no_of_inputs() const { return no_of_inputs; }
+
+	void set_one( uint64_t address );
+	void set_zero( uint64_t address );
+	void set_dontcare( uint64_t address );
+	void assign( const BitVector& ones, const BitVector& dontcares );
+
+	bool is_one( uint64_t address ) const { return on_set.test( address ); }
+	bool is_dontcare( uint64_t address ) const { return dc_set.test( address ); }
+	bool is_zero( uint64_t address ) const { return !on_set.test( address ) && !dc_set.test( address ); }
+
+	uint64_t count_ones() const { return on_set.count(); }
+	uint64_t count_dontcares() const { return dc_set.count(); }
+	uint64_t count_zeros() const { return size() - count_ones() - count_dontcares(); }
+
+	size_t get_word_count() const { return on_set.get_words().size(); }
+	uint64_t get_one_word( size_t index ) const { return on_set.get_words()[index]; }
+	uint64_t get_dontcare_word( size_t index ) const { return dc_set.get_words()[index]; }
+	uint64_t get_zero_word( size_t index ) const;
+
+	const BitVector& get_on_set() const { return on_set; }
+	const BitVector& get_dc_set() const { return dc_set; }
+
+private:
+	unsigned int no_of_inputs;
+	BitVector on_set;
+	BitVector dc_set;
+};
+
+#endif // TRUTHTABLE_H
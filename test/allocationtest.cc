@@ -0,0 +1,132 @@
+/*
+ * Copyright 2024 Alwin Leerling <dna.leerling@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+/* Heap allocations of repeated solves
+ *
+ * Every allocation through the global operator new is counted. Seeded random tables of
+ * three to eight inputs, with and without don't cares, are solved in the tabular mode,
+ * tables of up to six inputs with a few don't cares in the enumerating mode, all on one
+ * thread and without the cache. A first round over the tables
+ * lets the workspace grow to them, after that solving them again must not allocate at
+ * all, whether the same table is solved twice or the tables follow each other.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <vector>
+
+#include "check.h"
+#include "karnaughdata.h"
+
+/* One thread only allocates here, a plain counter does
+ */
+static unsigned long allocations = 0;
+
+void * operator new( size_t size )
+{
+	void * block = std::malloc( size ? size : 1 );
+
+	if( !block )
+		throw std::bad_alloc();
+
+	++allocations;
+
+	return block;
+}
+
+void operator delete( void * pointer ) noexcept { std::free( pointer ); }
+void * operator new[]( size_t size ) { return operator new( size ); }
+void operator delete[]( void * pointer ) noexcept { operator delete( pointer ); }
+void operator delete( void * pointer, size_t ) noexcept { operator delete( pointer ); }
+void operator delete[]( void * pointer, size_t ) noexcept { operator delete( pointer ); }
+
+static std::vector<TruthTable> random_tables( unsigned int no_of_inputs, unsigned int dontcares, std::mt19937& generator )
+{
+	std::uniform_int_distribution<unsigned int> percentage( 0, 99 );
+	std::vector<TruthTable> tables( 6 );
+
+	for( TruthTable& table : tables ) {
+		table.resize( no_of_inputs );
+
+		for( unsigned int address = 0; address < table.size(); ++address ) {
+			unsigned int draw = percentage( generator );
+
+			if( draw < dontcares )
+				table.set_dontcare( address );
+			else if( draw < dontcares + 45 )
+				table.set_one( address );
+		}
+	}
+
+	return tables;
+}
+
+static unsigned long solve_all( KarnaughData& data, const std::vector<TruthTable>& tables )
+{
+	unsigned long before = allocations;
+
+	for( const TruthTable& table : tables ) {
+		data.set_table( table );
+		data.find_best_solution();
+		data.find_best_solution();
+	}
+
+	return allocations - before;
+}
+
+static void check_steady_state( KarnaughData::eSolverMode mode, KarnaughData::eSolutionType type, unsigned int dontcares, unsigned int last_inputs )
+{
+	std::mt19937 generator( 13 + mode + type );
+	KarnaughData data;
+
+	data.set_solver_mode( mode );
+	data.set_solution_type( type );
+	data.set_thread_count( 1 );
+	data.set_cache_capacity( 0 );
+
+	for( unsigned int no_of_inputs = 3; no_of_inputs <= last_inputs; ++no_of_inputs ) {
+		std::vector<TruthTable> tables = random_tables( no_of_inputs, dontcares, generator );
+
+		data.set_dimension( no_of_inputs );
+		solve_all( data, tables );
+
+		unsigned long steady = solve_all( data, tables );
+
+		if( !CHECK( steady == 0 ) )
+			std::fprintf( stderr, "mode %d type %d, %u inputs: %lu allocations\n", mode, type, no_of_inputs, steady );
+	}
+
+	CHECK( data.get_verification_failures() == 0 );
+}
+
+int main()
+{
+	check_steady_state( KarnaughData::TABULAR, KarnaughData::SOP, 10, KarnaughData::exact_input_limit );
+	check_steady_state( KarnaughData::TABULAR, KarnaughData::POS, 10, KarnaughData::exact_input_limit );
+	check_steady_state( KarnaughData::TABULAR, KarnaughData::SOP, 0, KarnaughData::exact_input_limit );
+
+	/* every don't care doubles the scenarios to solve, a few of them on small tables do
+	 */
+	check_steady_state( KarnaughData::ENUMERATE, KarnaughData::SOP, 5, 6 );
+	check_steady_state( KarnaughData::ENUMERATE, KarnaughData::POS, 5, 6 );
+
+	return check_result();
+}
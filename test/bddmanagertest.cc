@@ -0,0 +1,200 @@
+/*
+ * Copyright 2024 Alwin Leerling <dna.leerling@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+/* Binary decision diagrams and the covers read off them
+ *
+ * The operations on seeded random functions of two to twelve variables have to agree
+ * with the same operations on their cells, and equal functions have to be the same
+ * node. An ISOP cover has to lie between its bounds and lose a lower cell with any cube
+ * taken out. Sifting has to keep every function and may not add nodes, a badly ordered
+ * function has to come out at its smallest size. The ISOP solver mode of KarnaughData
+ * has to give correct covers.
+ */
+
+#include <random>
+#include <vector>
+
+#include "check.h"
+#include "bddmanager.h"
+#include "karnaughdata.h"
+
+static BitVector random_cells( unsigned int no_of_variables, std::mt19937& generator )
+{
+	std::uniform_int_distribution<unsigned int> percentage( 0, 99 );
+	unsigned int density = percentage( generator );
+	BitVector cells( size_t(1) << no_of_variables );
+
+	for( size_t address = 0; address < cells.size(); ++address )
+		if( percentage( generator ) < density )
+			cells.set( address );
+
+	return cells;
+}
+
+static BitVector function_of( BddManager& bdd, BddManager::Node f )
+{
+	return SolutionEntry::GetCoverage( bdd.isop( f, f ), uint64_t(1) << bdd.get_variable_count() );
+}
+
+static void check_operations()
+{
+	std::mt19937 generator( 17 );
+
+	for( unsigned int function = 0; function < 200; ++function ) {
+		unsigned int no_of_variables = 2 + function % 11;
+		BddManager bdd( no_of_variables );
+		BitVector f_cells = random_cells( no_of_variables, generator );
+		BitVector g_cells = random_cells( no_of_variables, generator );
+		BddManager::Node f = bdd.from_cells( f_cells );
+		BddManager::Node g = bdd.from_cells( g_cells );
+
+		BitVector and_cells( f_cells );
+		BitVector or_cells( f_cells );
+		BitVector not_cells( f_cells.size() );
+
+		and_cells &= g_cells;
+		or_cells |= g_cells;
+		not_cells.fill();
+		not_cells.remove( f_cells );
+
+		CHECK( bdd.from_cells( f_cells ) == f );
+		CHECK( function_of( bdd, f ) == f_cells );
+		CHECK( bdd.apply_and( f, g ) == bdd.from_cells( and_cells ) );
+		CHECK( bdd.apply_or( f, g ) == bdd.from_cells( or_cells ) );
+		CHECK( bdd.negate( f ) == bdd.from_cells( not_cells ) );
+		CHECK( bdd.apply_xor( f, g ) == bdd.apply_and( bdd.apply_or( f, g ), bdd.negate( bdd.apply_and( f, g ) ) ) );
+		CHECK( !bdd.is_overflowed() );
+	}
+}
+
+static void check_isop()
+{
+	std::mt19937 generator( 18 );
+
+	for( unsigned int function = 0; function < 200; ++function ) {
+		unsigned int no_of_variables = 2 + function % 11;
+		uint64_t max_address = uint64_t(1) << no_of_variables;
+		BddManager bdd( no_of_variables );
+		BitVector lower = random_cells( no_of_variables, generator );
+		BitVector upper = random_cells( no_of_variables, generator );
+
+		upper |= lower;
+
+		SolutionEntries cover = bdd.isop( bdd.from_cells( lower ), bdd.from_cells( upper ) );
+		BitVector covered = SolutionEntry::GetCoverage( cover, max_address );
+
+		CHECK( lower.is_subset_of( covered ) );
+		CHECK( covered.is_subset_of( upper ) );
+
+		for( size_t index = 0; index < cover.size(); ++index ) {
+			SolutionEntries rest( cover );
+
+			rest.erase( rest.begin() + index );
+			CHECK( !lower.is_subset_of( SolutionEntry::GetCoverage( rest, max_address ) ) );
+		}
+	}
+}
+
+static void check_sift()
+{
+	std::mt19937 generator( 19 );
+
+	for( unsigned int function = 0; function < 60; ++function ) {
+		unsigned int no_of_variables = 3 + function % 8;
+		BddManager bdd( no_of_variables );
+		std::vector<BitVector> cells;
+		std::vector<BddManager::Node> roots;
+
+		for( unsigned int root = 0; root < 1 + function % 3; ++root ) {
+			cells.push_back( random_cells( no_of_variables, generator ) );
+			roots.push_back( bdd.from_cells( cells.back() ) );
+		}
+
+		size_t before = bdd.count_nodes( roots );
+
+		bdd.sift( roots );
+
+		CHECK( bdd.count_nodes( roots ) <= before );
+
+		for( size_t root = 0; root < roots.size(); ++root ) {
+			CHECK( function_of( bdd, roots[root] ) == cells[root] );
+			CHECK( bdd.from_cells( cells[root] ) == roots[root] );
+		}
+	}
+
+	/* x0 x8 + x1 x9 + ... + x7 x15 takes 2^9 - 2 nodes in the natural order, 16 with
+	 * every pair next to each other
+	 */
+	BddManager bdd( 16 );
+	BddManager::Node f = BddManager::false_node;
+
+	for( unsigned int pair = 0; pair < 8; ++pair )
+		f = bdd.apply_or( f, bdd.apply_and( bdd.variable( pair ), bdd.variable( pair + 8 ) ) );
+
+	std::vector<BddManager::Node> roots( 1, f );
+
+	CHECK( bdd.count_nodes( roots ) == 510 );
+
+	bdd.sift( roots );
+
+	CHECK( bdd.count_nodes( roots ) == 16 );
+	CHECK( bdd.isop( roots[0], roots[0] ).size() == 8 );
+}
+
+static void check_node_limit()
+{
+	std::mt19937 generator( 20 );
+	BddManager bdd( 12, 100 );
+
+	bdd.from_cells( random_cells( 12, generator ) );
+
+	CHECK( bdd.is_overflowed() );
+}
+
+static void check_solver_mode()
+{
+	std::mt19937 generator( 21 );
+	std::uniform_int_distribution<unsigned int> value( 0, 2 );
+	KarnaughData data;
+
+	data.set_solver_mode( KarnaughData::ISOP );
+
+	for( unsigned int function = 0; function < 100; ++function ) {
+		data.set_dimension( 1 + function % 12 );
+		data.set_solution_type( (function & 1) ? KarnaughData::POS : KarnaughData::SOP );
+
+		for( unsigned int address = 0; address < (1u << data.get_dimension()); ++address )
+			data.set_value( address, KarnaughData::eCellValues( value( generator ) ) );
+
+		data.find_best_solution();
+	}
+
+	CHECK( data.get_verification_failures() == 0 );
+}
+
+int main()
+{
+	check_operations();
+	check_isop();
+	check_sift();
+	check_node_limit();
+	check_solver_mode();
+
+	return check_result();
+}
@@ -0,0 +1,60 @@
+/*
+ * Copyright 2024 Alwin Leerling <dna.leerling@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#ifndef CHECK_H
+#define CHECK_H
+
+#include <cstdio>
+
+/* The checks of the unit tests
+ *
+ * CHECK reports a failed condition with its place and carries on, so one run shows
+ * every failure. check_result gives the exit code for main, which ctest takes as the
+ * outcome of the test.
+ */
+#define CHECK( condition ) check_condition( (condition), #condition, __FILE__, __LINE__ )
+
+inline unsigned int& check_failures()
+{
+	static unsigned int failures = 0;
+
+	return failures;
+}
+
+inline bool check_condition( bool condition, const char * text, const char * file, int line )
+{
+	if( !condition ) {
+		std::fprintf( stderr, "%s:%d: check failed: %s\n", file, line, text );
+		++check_failures();
+	}
+
+	return condition;
+}
+
+inline int check_result()
+{
+	if( check_failures() ) {
+		std::fprintf( stderr, "%u checks failed\n", check_failures() );
+		return 1;
+	}
+
+	return 0;
+}
+
+#endif // CHECK_H
@@ -0,0 +1,470 @@
+/*
+ * Copyright 2024 Alwin Leerling <dna.leerling@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+/* Exact minimum covers
+ *
+ * A few functions with a known minimum, then seeded random functions of up to four
+ * inputs against a search over every combination of their primes. The solvers have to
+ * find a cover with the fewest terms and within those the fewest literals, in both the
+ * tabular and the enumerating mode and for sums as well as products.
+ *
+ * Charts of up to 32 rows are left to Petrick's method, so functions of six to eight
+ * inputs with more primes than that check the branch and bound search and its lower
+ * bound. A search of its own, with a bound of disjoint cells, has to show there is no
+ * cover with fewer terms, or as many terms and fewer literals, while it does find the
+ * cover when allowed one literal more.
+ */
+
+#include <algorithm>
+#include <bitset>
+#include <random>
+#include <vector>
+
+#include "check.h"
+#include "karnaughdata.h"
+#include "quinemccluskey.h"
+
+struct Cost
+{
+	unsigned int terms;
+	unsigned int literals;
+
+	bool operator<( const Cost& rhs ) const { return (terms < rhs.terms) || ((terms == rhs.terms) && (literals < rhs.literals)); }
+	bool operator==( const Cost& rhs ) const { return (terms == rhs.terms) && (literals == rhs.literals); }
+};
+
+static Cost cost_of( const SolutionEntries& cover )
+{
+	Cost cost { unsigned( cover.size() ), 0 };
+
+	for( const SolutionEntry& entry : cover )
+		cost.literals += entry.GetLiteralCount();
+
+	return cost;
+}
+
+static uint32_t cells_of( const SolutionEntry& entry, unsigned int no_of_inputs )
+{
+	uint32_t cells = 0;
+
+	for( unsigned int address : entry.GetAddresses( 1u << no_of_inputs ) )
+		cells |= uint32_t(1) << address;
+
+	return cells;
+}
+
+/* Every cover has to take one of the primes of its lowest uncovered cell
+ */
+static void search( const std::vector<uint32_t>& cells, const SolutionEntries& primes, uint32_t uncovered, Cost cost, Cost& best )
+{
+	if( !(cost < best) )
+		return;
+
+	if( !uncovered ) {
+		best = cost;
+		return;
+	}
+
+	uint32_t lowest = uncovered & -uncovered;
+
+	for( size_t index = 0; index < primes.size(); ++index )
+		if( cells[index] & lowest )
+			search( cells, primes, uncovered & ~cells[index], Cost { cost.terms + 1, cost.literals + primes[index].GetLiteralCount() }, best );
+}
+
+static Cost minimum_cost( unsigned int no_of_inputs, const std::vector<KarnaughData::eCellValues>& values, KarnaughData::eCellValues target )
+{
+	std::vector<unsigned int> addresses;
+	uint32_t targets = 0;
+
+	for( unsigned int address = 0; address < values.size(); ++address ) {
+		if( values[address] == target )
+			targets |= uint32_t(1) << address;
+
+		if( (values[address] == target) || (values[address] == KarnaughData::DONTCARE) )
+			addresses.push_back( address );
+	}
+
+	QuineMcCluskey engine( no_of_inputs );
+	SolutionEntries primes = engine.find_prime_implicants( addresses );
+	std::vector<uint32_t> cells;
+
+	for( const SolutionEntry& prime : primes )
+		cells.push_back( cells_of( prime, no_of_inputs ) );
+
+	Cost best { ~0u, ~0u };
+
+	search( cells, primes, targets, Cost { 0, 0 }, best );
+
+	return best;
+}
+
+/* The cover has to take in every target cell and nothing outside the targets and don't cares
+ */
+static bool is_cover( const SolutionEntries& cover, unsigned int no_of_inputs, const std::vector<KarnaughData::eCellValues>& values, KarnaughData::eCellValues target )
+{
+	uint32_t covered = 0;
+
+	for( const SolutionEntry& entry : cover )
+		covered |= cells_of( entry, no_of_inputs );
+
+	for( unsigned int address = 0; address < values.size(); ++address ) {
+		bool is_covered = (covered >> address) & 1;
+
+		if( (values[address] == target) && !is_covered )
+			return false;
+
+		if( (values[address] != target) && (values[address] != KarnaughData::DONTCARE) && is_covered )
+			return false;
+	}
+
+	return true;
+}
+
+static SolutionEntries solve( KarnaughData& data, unsigned int no_of_inputs, const std::vector<KarnaughData::eCellValues>& values )
+{
+	data.set_dimension( no_of_inputs );
+
+	for( unsigned int address = 0; address < values.size(); ++address )
+		data.set_value( address, values[address] );
+
+	return data.find_best_solution();
+}
+
+static std::vector<KarnaughData::eCellValues> from_ones( unsigned int no_of_inputs, const std::vector<unsigned int>& ones, const std::vector<unsigned int>& dontcares = {} )
+{
+	std::vector<KarnaughData::eCellValues> values( 1u << no_of_inputs, KarnaughData::ZERO );
+
+	for( unsigned int address : ones )
+		values[address] = KarnaughData::ONE;
+
+	for( unsigned int address : dontcares )
+		values[address] = KarnaughData::DONTCARE;
+
+	return values;
+}
+
+static void check_known_functions()
+{
+	KarnaughData data;
+	SolutionEntries cover;
+
+	cover = solve( data, 3, from_ones( 3, {} ) );
+	CHECK( cover.empty() );
+
+	cover = solve( data, 3, from_ones( 3, { 0, 1, 2, 3, 4, 5, 6, 7 } ) );
+	CHECK( (cover.size() == 1) && (cover[0].GetMask() == 0) );
+
+	/* majority of three
+	 */
+	cover = solve( data, 3, from_ones( 3, { 3, 5, 6, 7 } ) );
+	CHECK( cost_of( cover ) == (Cost { 3, 6 }) );
+
+	/* a cyclic chart, no prime is essential
+	 */
+	cover = solve( data, 3, from_ones( 3, { 0, 1, 2, 5, 6, 7 } ) );
+	CHECK( cost_of( cover ) == (Cost { 3, 6 }) );
+
+	/* parity of four, nothing combines
+	 */
+	cover = solve( data, 4, from_ones( 4, { 1, 2, 4, 7, 8, 11, 13, 14 } ) );
+	CHECK( cost_of( cover ) == (Cost { 8, 32 }) );
+
+	/* the don't cares let x0 x1 + x2' x3' cover it
+	 */
+	cover = solve( data, 4, from_ones( 4, { 1, 3, 7, 11, 15 }, { 0, 2, 5 } ) );
+	CHECK( cost_of( cover ) == (Cost { 2, 4 }) );
+	CHECK( data.is_solution_optimal() );
+
+	/* the same majority as a product of sums covers the zeros
+	 */
+	data.set_solution_type( KarnaughData::POS );
+	cover = solve( data, 3, from_ones( 3, { 3, 5, 6, 7 } ) );
+	CHECK( cost_of( cover ) == (Cost { 3, 6 }) );
+	CHECK( is_cover( cover, 3, from_ones( 3, { 3, 5, 6, 7 } ), KarnaughData::ZERO ) );
+}
+
+static void check_random_functions( KarnaughData::eSolverMode mode, KarnaughData::eSolutionType type )
+{
+	std::mt19937 generator( 1 + mode * 2 + type );
+	std::uniform_int_distribution<unsigned int> percentage( 0, 99 );
+	KarnaughData::eCellValues target = (type == KarnaughData::POS) ? KarnaughData::ZERO : KarnaughData::ONE;
+	KarnaughData data;
+
+	data.set_solver_mode( mode );
+	data.set_solution_type( type );
+
+	for( unsigned int function = 0; function < 400; ++function ) {
+		unsigned int no_of_inputs = 1 + function % 4;
+		unsigned int ones = percentage( generator );
+		unsigned int dontcares = percentage( generator ) / 3;
+		std::vector<KarnaughData::eCellValues> values( 1u << no_of_inputs );
+
+		for( KarnaughData::eCellValues& value : values ) {
+			unsigned int draw = percentage( generator );
+
+			value = (draw < dontcares) ? KarnaughData::DONTCARE : (draw < dontcares + ones) ? KarnaughData::ONE : KarnaughData::ZERO;
+		}
+
+		SolutionEntries cover = solve( data, no_of_inputs, values );
+
+		CHECK( is_cover( cover, no_of_inputs, values, target ) );
+		CHECK( cost_of( cover ) == minimum_cost( no_of_inputs, values, target ) );
+		CHECK( data.is_solution_optimal() );
+	}
+}
+
+typedef std::bitset<256> Cells;
+
+/* The primes and cells of a function of up to eight inputs
+ *
+ * Two target cells that no prime covers both need two different primes, so the size of
+ * a set of such cells bounds the terms still needed, and the cheapest prime of each of
+ * them the literals. neighbours[c] holds the cells sharing a prime with c, the bound
+ * takes the cells with the fewest primes first.
+ */
+struct LargeChart
+{
+	SolutionEntries primes;
+	std::vector<Cells> cells;				// per prime
+	std::vector<std::vector<unsigned int>> covering;	// per cell, the primes covering it
+	std::vector<Cells> neighbours;			// per cell
+	std::vector<unsigned int> cheapest;		// per cell, the fewest literals of a prime covering it
+	std::vector<unsigned int> order;		// the cells by number of primes covering them
+	std::vector<bool> excluded;				// primes a search above already tried
+};
+
+static Cost lower_bound( const LargeChart& chart, const Cells& uncovered )
+{
+	Cells blocked;
+	Cost bound { 0, 0 };
+
+	for( unsigned int cell : chart.order )
+		if( uncovered[cell] && !blocked[cell] ) {
+			blocked |= chart.neighbours[cell];
+			bound.terms += 1;
+			bound.literals += chart.cheapest[cell];
+		}
+
+	return bound;
+}
+
+/* Every cover has to take one of the primes of the cell with the fewest left. Once the
+ * covers with one of them are searched, that prime is left out of the later branches.
+ * So is a prime whose uncovered cells another prime, with no more literals, covers as
+ * well: swapping it for that one never makes a cover worse.
+ */
+static void search_large( LargeChart& chart, const Cells& uncovered, Cost cost, Cost& best )
+{
+	if( uncovered.none() ) {
+		if( cost < best )
+			best = cost;
+		return;
+	}
+
+	Cost bound = lower_bound( chart, uncovered );
+
+	if( !(Cost { cost.terms + bound.terms, cost.literals + bound.literals } < best) )
+		return;
+
+	std::vector<unsigned int> left_out;
+	std::vector<unsigned int> useful;
+
+	for( unsigned int prime = 0; prime < chart.primes.size(); ++prime )
+		if( !chart.excluded[prime] && (chart.cells[prime] & uncovered).any() )
+			useful.push_back( prime );
+
+	for( unsigned int prime : useful ) {
+		Cells cells = chart.cells[prime] & uncovered;
+
+		for( unsigned int other : useful ) {
+			Cells other_cells = chart.cells[other] & uncovered;
+
+			if( (other == prime) || chart.excluded[other] || ((cells & ~other_cells).any()) )
+				continue;
+
+			if( chart.primes[other].GetLiteralCount() > chart.primes[prime].GetLiteralCount() )
+				continue;
+
+			/* of two equal ones the later one stays
+			 */
+			if( (other_cells == cells) && (chart.primes[other].GetLiteralCount() == chart.primes[prime].GetLiteralCount()) && (other < prime) )
+				continue;
+
+			chart.excluded[prime] = true;
+			left_out.push_back( prime );
+			break;
+		}
+	}
+
+	unsigned int branch_cell = 256;
+	size_t fewest = ~size_t(0);
+
+	for( unsigned int cell = 0; cell < 256; ++cell )
+		if( uncovered[cell] ) {
+			size_t available = 0;
+
+			for( unsigned int prime : chart.covering[cell] )
+				available += !chart.excluded[prime];
+
+			if( available < fewest ) {
+				branch_cell = cell;
+				fewest = available;
+			}
+		}
+
+	for( unsigned int prime : chart.covering[branch_cell] )
+		if( !chart.excluded[prime] ) {
+			search_large( chart, uncovered & ~chart.cells[prime], Cost { cost.terms + 1, cost.literals + chart.primes[prime].GetLiteralCount() }, best );
+
+			chart.excluded[prime] = true;
+			left_out.push_back( prime );
+		}
+
+	for( unsigned int prime : left_out )
+		chart.excluded[prime] = false;
+}
+
+/* Whether a cover cheaper than the given cost exists
+ */
+static bool has_cheaper_cover( unsigned int no_of_inputs, const std::vector<KarnaughData::eCellValues>& values, KarnaughData::eCellValues target, Cost cost )
+{
+	std::vector<unsigned int> addresses;
+	Cells targets;
+	LargeChart chart;
+
+	for( unsigned int address = 0; address < values.size(); ++address ) {
+		targets[address] = (values[address] == target);
+
+		if( (values[address] == target) || (values[address] == KarnaughData::DONTCARE) )
+			addresses.push_back( address );
+	}
+
+	QuineMcCluskey engine( no_of_inputs );
+
+	chart.primes = engine.find_prime_implicants( addresses );
+	chart.covering.resize( 256 );
+	chart.neighbours.resize( 256 );
+	chart.cheapest.assign( 256, ~0u );
+
+	for( unsigned int prime = 0; prime < chart.primes.size(); ++prime ) {
+		Cells cells;
+
+		for( unsigned int address : chart.primes[prime].GetAddresses( 1u << no_of_inputs ) ) {
+			cells.set( address );
+			chart.covering[address].push_back( prime );
+			chart.cheapest[address] = std::min( chart.cheapest[address], chart.primes[prime].GetLiteralCount() );
+		}
+
+		chart.cells.push_back( cells );
+	}
+
+	for( unsigned int cell = 0; cell < 256; ++cell ) {
+		for( unsigned int prime : chart.covering[cell] )
+			chart.neighbours[cell] |= chart.cells[prime];
+
+		chart.order.push_back( cell );
+	}
+
+	std::stable_sort( chart.order.begin(), chart.order.end(), [&chart]( unsigned int lhs, unsigned int rhs ) { return chart.covering[lhs].size() < chart.covering[rhs].size(); } );
+	chart.excluded.assign( chart.primes.size(), false );
+
+	Cost best = cost;
+
+	search_large( chart, targets, Cost { 0, 0 }, best );
+
+	return best < cost;
+}
+
+static bool is_large_cover( const SolutionEntries& cover, unsigned int no_of_inputs, const std::vector<KarnaughData::eCellValues>& values, KarnaughData::eCellValues target )
+{
+	Cells covered;
+
+	for( const SolutionEntry& entry : cover )
+		for( unsigned int address : entry.GetAddresses( 1u << no_of_inputs ) )
+			covered.set( address );
+
+	for( unsigned int address = 0; address < values.size(); ++address ) {
+		if( (values[address] == target) && !covered[address] )
+			return false;
+
+		if( (values[address] != target) && (values[address] != KarnaughData::DONTCARE) && covered[address] )
+			return false;
+	}
+
+	return true;
+}
+
+static void check_branch_and_bound( KarnaughData::eSolutionType type )
+{
+	std::mt19937 generator( 3 + type );
+	std::uniform_int_distribution<unsigned int> percentage( 0, 99 );
+	KarnaughData::eCellValues target = (type == KarnaughData::POS) ? KarnaughData::ZERO : KarnaughData::ONE;
+	KarnaughData data;
+	unsigned int searched = 0;
+
+	data.set_solution_type( type );
+	data.set_cache_capacity( 0 );
+
+	for( unsigned int function = 0; function < 60; ++function ) {
+		unsigned int no_of_inputs = 6 + function % 3;
+		std::vector<KarnaughData::eCellValues> values( 1u << no_of_inputs );
+
+		for( KarnaughData::eCellValues& value : values ) {
+			unsigned int draw = percentage( generator );
+
+			value = (draw < 10) ? KarnaughData::DONTCARE : (draw < 55) ? KarnaughData::ONE : KarnaughData::ZERO;
+		}
+
+		SolutionEntries cover = solve( data, no_of_inputs, values );
+		Cost cost = cost_of( cover );
+
+		CHECK( is_large_cover( cover, no_of_inputs, values, target ) );
+		CHECK( data.is_solution_optimal() );
+		CHECK( data.get_verification_failures() == 0 );
+
+		/* only the charts the reductions and Petrick's method leave to the search
+		 */
+		if( data.get_cover_statistics().used_petrick || !data.get_cover_statistics().search_nodes )
+			continue;
+
+		++searched;
+
+		/* no cheaper cover, but one with a literal more is beaten: the cover itself
+		 */
+		CHECK( !has_cheaper_cover( no_of_inputs, values, target, cost ) );
+		CHECK( has_cheaper_cover( no_of_inputs, values, target, Cost { cost.terms, cost.literals + 1 } ) );
+	}
+
+	CHECK( searched >= 10 );
+}
+
+int main()
+{
+	check_known_functions();
+	check_branch_and_bound( KarnaughData::SOP );
+	check_branch_and_bound( KarnaughData::POS );
+
+	check_random_functions( KarnaughData::TABULAR, KarnaughData::SOP );
+	check_random_functions( KarnaughData::TABULAR, KarnaughData::POS );
+	check_random_functions( KarnaughData::ENUMERATE, KarnaughData::SOP );
+	check_random_functions( KarnaughData::ENUMERATE, KarnaughData::POS );
+
+	return check_result();
+}
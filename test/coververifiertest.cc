@@ -0,0 +1,136 @@
+/*
+ * Copyright 2024 Alwin Leerling <dna.leerling@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+/* Cover verification a word at a time
+ *
+ * Seeded random tables of one to twelve inputs, so within one word and across several,
+ * are checked against correct covers and against random ones. The verifier has to agree
+ * with a cell by cell check on whether a cover is correct, and for a wrong one report
+ * the lowest wrong cell and whether it was left out or covered by mistake. Both the
+ * table and the bounds overload are checked, the table one for sums and products.
+ */
+
+#include <random>
+#include <vector>
+
+#include "check.h"
+#include "coververifier.h"
+#include "truthtable.h"
+
+struct Verdict
+{
+	uint64_t error_address;
+	bool error_missing;
+};
+
+static bool is_covered( const SolutionEntries& cover, unsigned int address )
+{
+	for( const SolutionEntry& entry : cover )
+		if( (address & entry.GetMask()) == entry.GetNumber() )
+			return true;
+
+	return false;
+}
+
+static Verdict check_cells( const SolutionEntries& cover, const TruthTable& table, bool zeros )
+{
+	for( unsigned int address = 0; address < table.size(); ++address ) {
+		bool is_target = zeros ? table.is_zero( address ) : table.is_one( address );
+		bool covered = is_covered( cover, address );
+
+		if( is_target && !covered )
+			return Verdict { address, true };
+
+		if( covered && !is_target && !table.is_dontcare( address ) )
+			return Verdict { address, false };
+	}
+
+	return Verdict { BitVector::npos, false };
+}
+
+static void check_verdict( CoverVerifier& verifier, bool correct, const Verdict& expected )
+{
+	CHECK( correct == (expected.error_address == BitVector::npos) );
+	CHECK( verifier.get_error_address() == expected.error_address );
+
+	if( !correct )
+		CHECK( verifier.is_error_missing() == expected.error_missing );
+}
+
+int main()
+{
+	std::mt19937 generator( 22 );
+	std::uniform_int_distribution<unsigned int> value( 0, 2 );
+	CoverVerifier verifier;
+
+	for( unsigned int function = 0; function < 600; ++function ) {
+		unsigned int no_of_inputs = 1 + function % 12;
+		unsigned int all_inputs = (1u << no_of_inputs) - 1;
+		bool zeros = function & 1;
+		TruthTable table;
+		SolutionEntries cover;
+
+		table.resize( no_of_inputs );
+
+		for( unsigned int address = 0; address <= all_inputs; ++address )
+			switch( value( generator ) ) {
+			case 0: table.set_one( address ); break;
+			case 1: table.set_dontcare( address ); break;
+			default: table.set_zero( address ); break;
+			}
+
+		/* a third of the covers are correct: every target cell and some don't cares,
+		 * the others random cubes
+		 */
+		if( function % 3 == 0 ) {
+			for( unsigned int address = 0; address <= all_inputs; ++address )
+				if( (zeros ? table.is_zero( address ) : table.is_one( address )) || (table.is_dontcare( address ) && (generator() & 1)) )
+					cover.push_back( SolutionEntry( all_inputs, address ) );
+		} else {
+			unsigned int no_of_cubes = generator() % (2 * no_of_inputs + 1);
+
+			for( unsigned int cube = 0; cube < no_of_cubes; ++cube ) {
+				unsigned int mask = generator() & all_inputs;
+
+				cover.push_back( SolutionEntry( mask, generator() & mask ) );
+			}
+		}
+
+		Verdict expected = check_cells( cover, table, zeros );
+
+		check_verdict( verifier, verifier.verify( cover, table, zeros ), expected );
+
+		/* the same through explicit bounds
+		 */
+		BitVector lower = zeros ? BitVector( table.size() ) : table.get_on_set();
+		BitVector upper( table.size() );
+
+		if( zeros )
+			for( unsigned int address = 0; address <= all_inputs; ++address )
+				if( table.is_zero( address ) )
+					lower.set( address );
+
+		upper |= lower;
+		upper |= table.get_dc_set();
+
+		check_verdict( verifier, verifier.verify( cover, lower, upper ), expected );
+	}
+
+	return check_result();
+}
@@ -0,0 +1,161 @@
+/*
+ * Copyright 2024 Alwin Leerling <dna.leerling@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+/* The heuristic minimiser
+ *
+ * Seeded random functions of three to ten inputs, given as one cube per cell. Every
+ * cover Espresso returns has to take in the ON-set and stay out of the OFF-set, every
+ * cube has to be prime and none may be covered by the others and the don't cares.
+ * A minimisation stopped before it began still has to give a correct cover.
+ */
+
+#include <random>
+#include <vector>
+
+#include "check.h"
+#include "espresso.h"
+#include "bitvector.h"
+
+struct Function
+{
+	unsigned int no_of_inputs;
+	SolutionEntries on_set;
+	SolutionEntries dc_set;
+	SolutionEntries off_set;
+};
+
+static Function make_function( unsigned int no_of_inputs, std::mt19937& generator )
+{
+	std::uniform_int_distribution<unsigned int> percentage( 0, 99 );
+	unsigned int ones = percentage( generator );
+	unsigned int dontcares = percentage( generator ) / 3;
+	unsigned int all_inputs = (1u << no_of_inputs) - 1;
+	Function function { no_of_inputs, {}, {}, {} };
+
+	for( unsigned int address = 0; address <= all_inputs; ++address ) {
+		unsigned int draw = percentage( generator );
+
+		if( draw < dontcares )
+			function.dc_set.push_back( SolutionEntry( all_inputs, address ) );
+		else if( draw < dontcares + ones )
+			function.on_set.push_back( SolutionEntry( all_inputs, address ) );
+		else
+			function.off_set.push_back( SolutionEntry( all_inputs, address ) );
+	}
+
+	return function;
+}
+
+static void check_cover( const Function& function, const SolutionEntries& cover, bool minimised )
+{
+	uint64_t max_address = uint64_t(1) << function.no_of_inputs;
+	BitVector covered = SolutionEntry::GetCoverage( cover, max_address );
+	BitVector dontcares = SolutionEntry::GetCoverage( function.dc_set, max_address );
+
+	CHECK( SolutionEntry::GetCoverage( function.on_set, max_address ).is_subset_of( covered ) );
+	CHECK( !SolutionEntry::GetCoverage( function.off_set, max_address ).intersects( covered ) );
+
+	if( !minimised )
+		return;
+
+	BitVector offset = SolutionEntry::GetCoverage( function.off_set, max_address );
+
+	for( size_t index = 0; index < cover.size(); ++index ) {
+		const SolutionEntry& cube = cover[index];
+		SolutionEntries others( cover );
+
+		others.erase( others.begin() + index );
+
+		BitVector rest = SolutionEntry::GetCoverage( others, max_address );
+
+		rest |= dontcares;
+		CHECK( !SolutionEntry::GetCoverage( SolutionEntries( 1, cube ), max_address ).is_subset_of( rest ) );
+
+		/* raising any literal has to run into the OFF-set
+		 */
+		for( unsigned int variable = 0; variable < function.no_of_inputs; ++variable ) {
+			unsigned int bit = 1u << variable;
+
+			if( !(cube.GetMask() & bit) )
+				continue;
+
+			SolutionEntry raised( cube.GetMask() & ~bit, cube.GetNumber() & ~bit );
+
+			CHECK( SolutionEntry::GetCoverage( SolutionEntries( 1, raised ), max_address ).intersects( offset ) );
+		}
+	}
+}
+
+static void check_random_functions()
+{
+	std::mt19937 generator( 5 );
+
+	for( unsigned int function_index = 0; function_index < 300; ++function_index ) {
+		Function function = make_function( 3 + function_index % 8, generator );
+		Espresso engine( function.no_of_inputs );
+
+		check_cover( function, engine.minimise( function.on_set, function.dc_set, function.off_set ), true );
+		CHECK( !engine.is_stopped() );
+	}
+}
+
+/* parity has no larger cubes, every ON cell stays a term of its own
+ */
+static void check_parity()
+{
+	Function function { 6, {}, {}, {} };
+
+	for( unsigned int address = 0; address < 64; ++address ) {
+		bool odd = __builtin_parity( address );
+
+		(odd ? function.on_set : function.off_set).push_back( SolutionEntry( 63, address ) );
+	}
+
+	Espresso engine( 6 );
+
+	CHECK( engine.minimise( function.on_set, function.dc_set, function.off_set ).size() == 32 );
+}
+
+static void check_stopped()
+{
+	std::mt19937 generator( 6 );
+	CancellationToken token;
+	SolveLimit limit;
+
+	token.cancel();
+	limit.set_token( &token );
+
+	for( unsigned int function_index = 0; function_index < 20; ++function_index ) {
+		Function function = make_function( 10, generator );
+		Espresso engine( function.no_of_inputs );
+
+		engine.set_solve_limit( &limit );
+		check_cover( function, engine.minimise( function.on_set, function.dc_set, function.off_set ), false );
+		CHECK( engine.is_stopped() );
+	}
+}
+
+int main()
+{
+	check_random_functions();
+	check_parity();
+	check_stopped();
+
+	return check_result();
+}
@@ -0,0 +1,82 @@
+/*
+ * Copyright 2024 Alwin Leerling <dna.leerling@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+/* The prime implicant kernel instantiated per number of inputs
+ *
+ * For every instantiation, from one to eight inputs, seeded random functions of every
+ * density, the empty and the full function go through the kernel and the generic
+ * tabulation. Both have to return the same primes in the same order, and the merges
+ * the kernel counts have to be the distinct merged implicants the generic one made.
+ * Other numbers of inputs have no instantiation.
+ */
+
+#include <random>
+#include <vector>
+
+#include "check.h"
+#include "fixedquinemccluskey.h"
+#include "quinemccluskey.h"
+#include "solverstatistics.h"
+
+static void check_function( unsigned int no_of_inputs, const std::vector<unsigned int>& addresses )
+{
+	QuineMcCluskey engine( no_of_inputs );
+	SolutionEntries expected = engine.find_prime_implicants( addresses );
+	SolutionEntries primes( 3, SolutionEntry( 0, 0 ) );			// whatever was in it is replaced
+	SolverStatistics statistics;
+
+	statistics.clear();
+
+	CHECK( find_fixed_prime_implicants( no_of_inputs, addresses, primes, &statistics ) );
+	CHECK( primes == expected );
+	CHECK( statistics.merges == engine.get_merges() - engine.get_duplicates() );
+}
+
+int main()
+{
+	std::mt19937 generator( 14 );
+	std::uniform_int_distribution<unsigned int> percentage( 0, 99 );
+
+	for( unsigned int no_of_inputs = 1; no_of_inputs <= 8; ++no_of_inputs ) {
+		std::vector<unsigned int> all;
+
+		for( unsigned int address = 0; address < (1u << no_of_inputs); ++address )
+			all.push_back( address );
+
+		check_function( no_of_inputs, std::vector<unsigned int>() );
+		check_function( no_of_inputs, all );
+
+		for( unsigned int density = 5; density < 100; density += 5 ) {
+			std::vector<unsigned int> addresses;
+
+			for( unsigned int address = 0; address < (1u << no_of_inputs); ++address )
+				if( percentage( generator ) < density )
+					addresses.push_back( address );
+
+			check_function( no_of_inputs, addresses );
+		}
+	}
+
+	SolutionEntries primes;
+
+	CHECK( !find_fixed_prime_implicants( 0, std::vector<unsigned int>(), primes ) );
+	CHECK( !find_fixed_prime_implicants( 9, std::vector<unsigned int>( 1, 0 ), primes ) );
+
+	return check_result();
+}
@@ -0,0 +1,148 @@
+/*
+ * Copyright 2024 Alwin Leerling <dna.leerling@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+/* Prime implicants updated in place on single cell edits
+ *
+ * Seeded random functions of one to eight inputs go through a series of random cell
+ * changes. After every change the primes updated in place have to be exactly the ones
+ * computed from scratch, in the same order. Through KarnaughData the solve that follows
+ * the edits has to be as cheap as the solve of a fresh table and pass verification.
+ */
+
+#include <random>
+#include <vector>
+
+#include "check.h"
+#include "karnaughdata.h"
+#include "quinemccluskey.h"
+
+static std::vector<unsigned int> to_addresses( const BitVector& cells )
+{
+	std::vector<unsigned int> addresses;
+
+	for( size_t address = cells.find_first(); address != BitVector::npos; address = cells.find_next( address + 1 ) )
+		addresses.push_back( address );
+
+	return addresses;
+}
+
+static unsigned int literals_of( const SolutionEntries& cover )
+{
+	unsigned int literals = 0;
+
+	for( const SolutionEntry& entry : cover )
+		literals += entry.GetLiteralCount();
+
+	return literals;
+}
+
+static void check_engine()
+{
+	std::mt19937 generator( 8 );
+
+	for( unsigned int function = 0; function < 200; ++function ) {
+		unsigned int no_of_inputs = 1 + function % 8;
+		unsigned int no_of_cells = 1u << no_of_inputs;
+		std::uniform_int_distribution<unsigned int> cell( 0, no_of_cells - 1 );
+		QuineMcCluskey engine( no_of_inputs );
+		BitVector cells( no_of_cells );
+
+		for( unsigned int address = 0; address < no_of_cells; ++address )
+			if( generator() & 1 )
+				cells.set( address );
+
+		SolutionEntries primes = engine.find_prime_implicants( to_addresses( cells ) );
+
+		for( unsigned int edit = 0; edit < 20; ++edit ) {
+			unsigned int address = cell( generator );
+
+			if( cells.test( address ) ) {
+				cells.reset( address );
+				engine.erase_address( primes, address );
+			} else {
+				cells.set( address );
+				engine.insert_address( primes, cells, address );
+			}
+
+			CHECK( primes == QuineMcCluskey( no_of_inputs ).find_prime_implicants( to_addresses( cells ) ) );
+		}
+	}
+}
+
+static void check_data()
+{
+	std::mt19937 generator( 9 );
+	std::uniform_int_distribution<unsigned int> value( 0, 2 );
+
+	for( unsigned int function = 0; function < 60; ++function ) {
+		unsigned int no_of_inputs = 2 + function % 7;
+		unsigned int no_of_cells = 1u << no_of_inputs;
+		std::uniform_int_distribution<unsigned int> cell( 0, no_of_cells - 1 );
+		KarnaughData data;
+
+		/* a cached solution would skip the primes kept by set_value
+		 */
+		data.set_cache_capacity( 0 );
+		data.set_dimension( no_of_inputs );
+
+		for( unsigned int address = 0; address < no_of_cells; ++address )
+			data.set_value( address, KarnaughData::eCellValues( value( generator ) ) );
+
+		data.find_best_solution();
+
+		for( unsigned int edit = 0; edit < 10; ++edit ) {
+			/* an empty or full table is solved without primes, there are none to keep up to date
+			 */
+			bool primes_kept = !data.get_prime_implicants().empty();
+
+			data.set_value( cell( generator ), KarnaughData::eCellValues( value( generator ) ) );
+
+			KarnaughData fresh;
+			std::vector<unsigned int> addresses;
+
+			fresh.set_dimension( no_of_inputs );
+
+			for( unsigned int address = 0; address < no_of_cells; ++address ) {
+				fresh.set_value( address, data.get_value( address ) );
+
+				if( data.get_value( address ) != KarnaughData::ZERO )
+					addresses.push_back( address );
+			}
+
+			if( primes_kept )
+				CHECK( data.get_prime_implicants() == QuineMcCluskey( no_of_inputs ).find_prime_implicants( addresses ) );
+
+			SolutionEntries updated = data.find_best_solution();
+			SolutionEntries expected = fresh.find_best_solution();
+
+			CHECK( updated.size() == expected.size() );
+			CHECK( literals_of( updated ) == literals_of( expected ) );
+		}
+
+		CHECK( data.get_verification_failures() == 0 );
+	}
+}
+
+int main()
+{
+	check_engine();
+	check_data();
+
+	return check_result();
+}
@@ -0,0 +1,162 @@
+/*
+ * Copyright 2024 Alwin Leerling <dna.leerling@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+/* Several outputs minimised together
+ *
+ * Two outputs that have a product in common have to share it. Seeded random functions
+ * of two to four outputs have to give covers that are correct for every output, through
+ * the exact solver and through the heuristic one, for sums and for products. A solve
+ * that runs to the end may not use more products than the outputs take one by one, and
+ * a cancelled one still has to be correct.
+ */
+
+#include <random>
+#include <vector>
+
+#include "check.h"
+#include "multioutputdata.h"
+#include "karnaughdata.h"
+
+static void check_shared_product()
+{
+	MultiOutputData data;
+
+	/* x0 x1 + x2 and x0 x1 + x2'
+	 */
+	data.set_dimension( 3, 2 );
+
+	for( unsigned int address = 0; address < 8; ++address ) {
+		bool both = (address & 3) == 3;
+
+		data.set_value( 0, address, (both || (address & 4)) ? KarnaughData::ONE : KarnaughData::ZERO );
+		data.set_value( 1, address, (both || !(address & 4)) ? KarnaughData::ONE : KarnaughData::ZERO );
+	}
+
+	const SharedProducts& products = data.find_best_solution();
+	unsigned int shared = 0;
+
+	CHECK( products.size() == 3 );
+	CHECK( data.get_literal_count() == 4 );
+	CHECK( data.verify_solution() );
+	CHECK( !data.is_solve_stopped() );
+
+	for( const SharedProduct& product : products )
+		if( product.outputs == 3 ) {
+			CHECK( (product.product.GetMask() == 3) && (product.product.GetNumber() == 3) );
+			++shared;
+		}
+
+	CHECK( shared == 1 );
+}
+
+static void fill( MultiOutputData& data, unsigned int no_of_inputs, unsigned int no_of_outputs, std::mt19937& generator )
+{
+	std::uniform_int_distribution<unsigned int> percentage( 0, 99 );
+
+	data.set_dimension( no_of_inputs, no_of_outputs );
+
+	for( unsigned int output = 0; output < no_of_outputs; ++output ) {
+		unsigned int ones = percentage( generator );
+		unsigned int dontcares = percentage( generator ) / 4;
+
+		for( unsigned int address = 0; address < (1u << no_of_inputs); ++address ) {
+			unsigned int draw = percentage( generator );
+
+			data.set_value( output, address, (draw < dontcares) ? KarnaughData::DONTCARE : (draw < dontcares + ones) ? KarnaughData::ONE : KarnaughData::ZERO );
+		}
+	}
+}
+
+/* The outputs solved one at a time are a cover of the whole as well
+ */
+static size_t separate_products( const MultiOutputData& data )
+{
+	size_t products = 0;
+
+	for( unsigned int output = 0; output < data.get_outputs(); ++output ) {
+		KarnaughData single;
+
+		single.set_dimension( data.get_dimension() );
+		single.set_solution_type( data.get_solution_type() );
+
+		for( unsigned int address = 0; address < (1u << data.get_dimension()); ++address )
+			single.set_value( address, data.get_value( output, address ) );
+
+		products += single.find_best_solution().size();
+	}
+
+	return products;
+}
+
+static void check_random_functions( KarnaughData::eSolutionType type, unsigned int first_inputs, unsigned int last_inputs, unsigned int count )
+{
+	std::mt19937 generator( 11 + type + first_inputs );
+	MultiOutputData data;
+
+	data.set_solution_type( type );
+
+	for( unsigned int function = 0; function < count; ++function ) {
+		unsigned int no_of_inputs = first_inputs + function % (last_inputs - first_inputs + 1);
+
+		fill( data, no_of_inputs, 2 + function % 3, generator );
+
+		const SharedProducts& products = data.find_best_solution();
+
+		CHECK( data.verify_solution() );
+
+		for( const SharedProduct& product : products )
+			CHECK( product.outputs != 0 );
+
+		if( !data.is_solve_stopped() && (no_of_inputs <= KarnaughData::exact_input_limit) )
+			CHECK( products.size() <= separate_products( data ) );
+	}
+}
+
+static void check_stopped()
+{
+	std::mt19937 generator( 12 );
+	CancellationToken token;
+	SolveLimit limit;
+	MultiOutputData data;
+
+	token.cancel();
+	limit.set_token( &token );
+
+	for( unsigned int function = 0; function < 10; ++function ) {
+		fill( data, (function & 1) ? 8 : 10, 4, generator );
+		data.find_best_solution( limit );
+
+		CHECK( data.verify_solution() );
+		CHECK( data.is_solve_stopped() );
+	}
+}
+
+int main()
+{
+	check_shared_product();
+
+	check_random_functions( KarnaughData::SOP, 2, 6, 150 );
+	check_random_functions( KarnaughData::POS, 2, 6, 150 );
+	check_random_functions( KarnaughData::SOP, 9, 10, 6 );
+	check_random_functions( KarnaughData::POS, 9, 10, 6 );
+
+	check_stopped();
+
+	return check_result();
+}
@@ -0,0 +1,200 @@
+/*
+ * Copyright 2024 Alwin Leerling <dna.leerling@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+/* Cache entries shared between NPN equivalent functions
+ *
+ * The transforms of the canonizer have to map cubes like the addresses in them, both
+ * ways. Then seeded random tables of six to eight inputs are solved once, and variants
+ * with the inputs permuted and negated, and with the output negated, are solved through
+ * the same KarnaughData. Every variant has to come out of the cache with a cover that is
+ * correct cell by cell and as cheap as the first one, and the check of the covers must
+ * never have had to replace one.
+ */
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "check.h"
+#include "karnaughdata.h"
+#include "npncanonizer.h"
+
+static unsigned int literals_of( const SolutionEntries& cover )
+{
+	unsigned int literals = 0;
+
+	for( const SolutionEntry& entry : cover )
+		literals += entry.GetLiteralCount();
+
+	return literals;
+}
+
+static bool contains( const SolutionEntry& entry, unsigned int address )
+{
+	return (address & entry.GetMask()) == entry.GetNumber();
+}
+
+static bool is_cover( const SolutionEntries& cover, const TruthTable& table, bool zeros )
+{
+	for( unsigned int address = 0; address < table.size(); ++address ) {
+		bool is_target = zeros ? table.is_zero( address ) : table.is_one( address );
+		bool covered = std::any_of( cover.begin(), cover.end(), [address]( const SolutionEntry& entry ) { return contains( entry, address ); } );
+
+		if( (is_target && !covered) || (covered && !is_target && !table.is_dontcare( address )) )
+			return false;
+	}
+
+	return true;
+}
+
+static TruthTable random_table( unsigned int no_of_inputs, std::mt19937& generator )
+{
+	std::uniform_int_distribution<unsigned int> percentage( 0, 99 );
+	unsigned int ones = 20 + percentage( generator ) / 2;
+	TruthTable table;
+
+	table.resize( no_of_inputs );
+
+	for( unsigned int address = 0; address < table.size(); ++address ) {
+		unsigned int draw = percentage( generator );
+
+		if( draw < 10 )
+			table.set_dontcare( address );
+		else if( draw < 10 + ones )
+			table.set_one( address );
+	}
+
+	return table;
+}
+
+/* The cell of address moves to address ^ negation with input i at position permutation[i]
+ */
+static TruthTable transform_table( const TruthTable& table, const std::vector<unsigned int>& permutation, unsigned int negation, bool complement )
+{
+	TruthTable variant;
+
+	variant.resize( table.get_no_of_inputs() );
+
+	for( unsigned int address = 0; address < table.size(); ++address ) {
+		unsigned int negated = address ^ negation;
+		unsigned int moved = 0;
+
+		for( unsigned int input = 0; input < permutation.size(); ++input )
+			moved |= ((negated >> input) & 1) << permutation[input];
+
+		if( table.is_dontcare( address ) )
+			variant.set_dontcare( moved );
+		else if( table.is_one( address ) != complement )
+			variant.set_one( moved );
+	}
+
+	return variant;
+}
+
+static void check_transforms()
+{
+	std::mt19937 generator( 10 );
+
+	for( unsigned int function = 0; function < 30; ++function ) {
+		unsigned int no_of_inputs = 1 + function % 8;
+		TruthTable table = random_table( no_of_inputs, generator );
+		BitVector canonical_target;
+		BitVector canonical_dontcare;
+		NpnCanonizer canonizer( no_of_inputs );
+		NpnTransform transform = canonizer.canonize( table.get_on_set(), table.get_dc_set(), canonical_target, canonical_dontcare );
+		unsigned int all = (1u << no_of_inputs) - 1;
+
+		for( unsigned int cube = 0; cube < 20; ++cube ) {
+			unsigned int mask = generator() & all;
+			SolutionEntry entry( mask, generator() & mask );
+			SolutionEntry canonical = transform.to_canonical( entry );
+
+			CHECK( transform.from_canonical( canonical ) == entry );
+			CHECK( canonical.GetLiteralCount() == entry.GetLiteralCount() );
+
+			for( unsigned int address = 0; address <= all; ++address )
+				CHECK( contains( entry, address ) == contains( canonical, transform.to_canonical( address ) ) );
+		}
+
+		/* the representative holds the function moved by the transform
+		 */
+		for( unsigned int address = 0; address <= all; ++address ) {
+			CHECK( canonical_target.test( transform.to_canonical( address ) ) == table.is_one( address ) );
+			CHECK( canonical_dontcare.test( transform.to_canonical( address ) ) == table.is_dontcare( address ) );
+		}
+	}
+}
+
+static void check_cache_hits( KarnaughData::eSolverMode mode )
+{
+	std::mt19937 generator( 10 + mode );
+	KarnaughData data;
+	SolverStatistics statistics;
+
+	data.set_solver_mode( mode );
+
+	for( unsigned int function = 0; function < 24; ++function ) {
+		unsigned int no_of_inputs = KarnaughData::npn_min_inputs + function % 3;
+		TruthTable table = random_table( no_of_inputs, generator );
+
+		data.set_solution_type( KarnaughData::SOP );
+		data.set_table( table );
+
+		SolutionEntries first = data.find_best_solution( statistics );
+
+		CHECK( !statistics.from_cache );
+		CHECK( is_cover( first, table, false ) );
+
+		for( unsigned int variant = 0; variant < 4; ++variant ) {
+			std::vector<unsigned int> permutation( no_of_inputs );
+			unsigned int negation = generator() & ((1u << no_of_inputs) - 1);
+			bool complement = variant & 1;
+
+			std::iota( permutation.begin(), permutation.end(), 0 );
+			std::shuffle( permutation.begin(), permutation.end(), generator );
+
+			/* the zeros of the complement are the ones of the function
+			 */
+			TruthTable moved = transform_table( table, permutation, negation, complement );
+
+			data.set_solution_type( complement ? KarnaughData::POS : KarnaughData::SOP );
+			data.set_table( moved );
+
+			SolutionEntries cover = data.find_best_solution( statistics );
+
+			CHECK( statistics.from_cache );
+			CHECK( is_cover( cover, moved, complement ) );
+			CHECK( cover.size() == first.size() );
+			CHECK( literals_of( cover ) == literals_of( first ) );
+		}
+	}
+
+	CHECK( data.get_verification_failures() == 0 );
+}
+
+int main()
+{
+	check_transforms();
+
+	check_cache_hits( KarnaughData::TABULAR );
+	check_cache_hits( KarnaughData::HEURISTIC );
+
+	return check_result();
+}
@@ -0,0 +1,182 @@
+/*
+ * Copyright 2024 Alwin Leerling <dna.leerling@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+/* Berkeley PLA files
+ *
+ * A small file of every type has to give the tables its products describe, malformed
+ * files have to be refused with a message. Seeded random functions written as PLA
+ * files have to read back to the same tables, and once minimised and written out the
+ * products have to read back as a correct cover of the original.
+ */
+
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "check.h"
+#include "plafile.h"
+#include "multioutputdata.h"
+
+static bool read_text( PlaFile& pla, const std::string& text )
+{
+	std::istringstream input( text );
+
+	return pla.read( input );
+}
+
+static void check_read()
+{
+	PlaFile pla;
+
+	/* the first input column is the highest address bit
+	 */
+	CHECK( read_text( pla, "# comment\n.i 3\n.o 2\n.ilb a b c\n.ob f g\n.type fd\n.p 3\n1-0 1~\n011 -1\n00- 01\n.e\n" ) );
+	CHECK( (pla.get_inputs() == 3) && (pla.get_outputs() == 2) && (pla.get_product_count() == 3) );
+
+	for( unsigned int address = 0; address < 8; ++address ) {
+		CHECK( pla.get_table( 0 ).is_one( address ) == ((address == 4) || (address == 6)) );
+		CHECK( pla.get_table( 0 ).is_dontcare( address ) == (address == 3) );
+		CHECK( pla.get_table( 1 ).is_one( address ) == (address <= 1 || address == 3) );
+		CHECK( !pla.get_table( 1 ).is_dontcare( address ) );
+	}
+
+	/* type f leaves out the don't cares
+	 */
+	CHECK( read_text( pla, ".i 2\n.o 1\n.type f\n1- 1\n01 -\n" ) );
+	CHECK( pla.get_table( 0 ).is_one( 2 ) && pla.get_table( 0 ).is_one( 3 ) && pla.get_table( 0 ).is_zero( 1 ) );
+
+	/* with an OFF-set whatever is not given is free
+	 */
+	CHECK( read_text( pla, ".i 2\n.o 1\n.type fr\n11 1\n00 0\n" ) );
+	CHECK( pla.get_table( 0 ).is_one( 3 ) && pla.get_table( 0 ).is_zero( 0 ) );
+	CHECK( pla.get_table( 0 ).is_dontcare( 1 ) && pla.get_table( 0 ).is_dontcare( 2 ) );
+}
+
+static void check_errors()
+{
+	const char * files[] = {
+		"11 1\n",									// product before .i
+		".i 2\n.o 1\n111 1\n",						// too many inputs
+		".i 2\n.o 1\n1x 1\n",						// invalid input value
+		".i 2\n.o 1\n11 x\n",						// invalid output value
+		".i 2\n.o 1\n.type fx\n11 1\n",				// unknown type
+		".i 99\n.o 1\n",							// too many inputs for a table
+		".i 2\n.o 1\n11 1\n.i 3\n",					// .i after the products
+		".o 1\n.e\n"								// no .i at all
+	};
+
+	for( const char * file : files ) {
+		PlaFile pla;
+
+		CHECK( !read_text( pla, file ) );
+		CHECK( !pla.get_error().empty() );
+	}
+}
+
+static std::string to_pla( unsigned int no_of_inputs, const std::vector<std::vector<char>>& outputs )
+{
+	std::ostringstream text;
+
+	text << ".i " << no_of_inputs << "\n.o " << outputs.size() << "\n.ilb";
+
+	for( unsigned int input = 0; input < no_of_inputs; ++input )
+		text << " in" << input;
+
+	text << "\n.type fd\n";
+
+	for( unsigned int address = 0; address < (1u << no_of_inputs); ++address ) {
+		for( unsigned int column = 0; column < no_of_inputs; ++column )
+			text << (((address >> (no_of_inputs - 1 - column)) & 1) ? '1' : '0');
+
+		text << ' ';
+
+		for( const std::vector<char>& output : outputs )
+			text << output[address];
+
+		text << "\n";
+	}
+
+	text << ".e\n";
+
+	return text.str();
+}
+
+static void check_round_trip()
+{
+	std::mt19937 generator( 19 );
+	std::uniform_int_distribution<unsigned int> value( 0, 2 );
+	MultiOutputData data;
+
+	for( unsigned int function = 0; function < 60; ++function ) {
+		unsigned int no_of_inputs = 3 + function % 4;
+		std::vector<std::vector<char>> outputs( 1 + function % 3, std::vector<char>( 1u << no_of_inputs ) );
+		PlaFile pla;
+
+		for( std::vector<char>& output : outputs )
+			for( char& cell : output )
+				cell = "01-"[value( generator )];
+
+		CHECK( read_text( pla, to_pla( no_of_inputs, outputs ) ) );
+
+		for( unsigned int output = 0; output < outputs.size(); ++output )
+			for( unsigned int address = 0; address < (1u << no_of_inputs); ++address ) {
+				CHECK( pla.get_table( output ).is_one( address ) == (outputs[output][address] == '1') );
+				CHECK( pla.get_table( output ).is_dontcare( address ) == (outputs[output][address] == '-') );
+			}
+
+		data.set_dimension( no_of_inputs, outputs.size() );
+
+		for( unsigned int output = 0; output < outputs.size(); ++output )
+			data.set_table( output, pla.get_table( output ) );
+
+		std::ostringstream written;
+		PlaFile minimised;
+
+		const SharedProducts& products = data.find_best_solution();
+
+		pla.write( written, products );
+
+		CHECK( written.str().find( ".ilb in0 in1 in2" ) != std::string::npos );
+		CHECK( read_text( minimised, written.str() ) );
+		CHECK( minimised.get_product_count() == products.size() );
+
+		for( unsigned int output = 0; output < outputs.size(); ++output )
+			for( unsigned int address = 0; address < (1u << no_of_inputs); ++address ) {
+				const TruthTable& table = minimised.get_table( output );
+
+				CHECK( !table.is_dontcare( address ) );
+
+				if( outputs[output][address] == '1' )
+					CHECK( table.is_one( address ) );
+
+				if( outputs[output][address] == '0' )
+					CHECK( table.is_zero( address ) );
+			}
+	}
+}
+
+int main()
+{
+	check_read();
+	check_errors();
+	check_round_trip();
+
+	return check_result();
+}
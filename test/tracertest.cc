@@ -0,0 +1,137 @@
+/*
+ * Copyright 2024 Alwin Leerling <dna.leerling@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+/* The ring buffers of the tracer
+ *
+ * A thread records fewer events than a buffer holds, exactly as many and more, and
+ * write() has to put out the latest ones in order, leaving out the oldest slot of a full
+ * buffer as its thread could be overwriting it. Then a second thread records without
+ * pause while the main thread writes the trace again and again: every event written has
+ * to be whole, its duration is tied to its name so a torn one shows.
+ */
+
+#include <atomic>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "check.h"
+#include "tracer.h"
+
+static const char * const names[] = { "e0", "e1", "e2", "e3", "e4", "e5", "e6", "e7" };
+
+struct Written
+{
+	unsigned int name;
+	unsigned int thread_id;
+	double duration;
+};
+
+/* Event number index has name index % 8 and lasts index % 8 microseconds
+ */
+static void record( uint64_t index )
+{
+	Tracer::Clock::time_point start = Tracer::Clock::now();
+
+	Tracer::record( names[index % 8], start, start + std::chrono::microseconds( index % 8 ) );
+}
+
+static std::vector<Written> write_trace()
+{
+	std::ostringstream out;
+	std::vector<Written> written;
+
+	CHECK( Tracer::write( out ) );
+
+	std::istringstream in( out.str() );
+	std::string line;
+
+	while( std::getline( in, line ) ) {
+		Written event;
+		double start;
+
+		if( std::sscanf( line.c_str(), "{\"name\":\"e%u\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%lf,\"dur\":%lf}", &event.name, &event.thread_id, &start, &event.duration ) == 4 )
+			written.push_back( event );
+		else
+			CHECK( line == "{\"traceEvents\":[" || line == "]}" );
+	}
+
+	return written;
+}
+
+static void check_sequence( const std::vector<Written>& written, uint64_t first, size_t count )
+{
+	if( !CHECK( written.size() == count ) )
+		return;
+
+	for( size_t index = 0; index < count; ++index ) {
+		CHECK( written[index].name == (first + index) % 8 );
+		CHECK( written[index].duration == (first + index) % 8 );
+	}
+}
+
+int main()
+{
+	Tracer::set_enabled( true );
+
+	/* Fewer events than fit, a full buffer and one that wrapped
+	 */
+	for( uint64_t index = 0; index < 100; ++index )
+		record( index );
+	check_sequence( write_trace(), 0, 100 );
+
+	for( uint64_t index = 100; index < Tracer::buffer_size; ++index )
+		record( index );
+	check_sequence( write_trace(), 1, Tracer::buffer_size - 1 );
+
+	for( uint64_t index = Tracer::buffer_size; index < Tracer::buffer_size + 1234; ++index )
+		record( index );
+	check_sequence( write_trace(), 1235, Tracer::buffer_size - 1 );
+
+	Tracer::clear();
+	CHECK( write_trace().empty() );
+
+	record( 5 );
+	check_sequence( write_trace(), 5, 1 );
+
+	/* Write while another thread keeps overwriting its buffer
+	 */
+	Tracer::clear();
+
+	std::atomic<bool> done( false );
+	std::thread recorder( [&done]() {
+		for( uint64_t index = 0; !done.load( std::memory_order_relaxed ); ++index )
+			record( index );
+	} );
+
+	for( unsigned int round = 0; round < 50; ++round ) {
+		std::vector<Written> written = write_trace();
+
+		CHECK( written.size() <= 2 * Tracer::buffer_size );
+
+		for( const Written& event : written )
+			CHECK( event.name < 8 && event.duration == event.name );
+	}
+
+	done = true;
+	recorder.join();
+
+	return check_result();
+}